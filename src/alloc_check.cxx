@@ -0,0 +1,147 @@
+#include <errno.h>
+#include <string.h>
+#include "alloc_check.h"
+
+static bool enabled = false;
+static bool warm = false;
+static __thread int armed = 0;
+
+static uint64_t count = 0;
+static uint64_t bytes = 0;
+static int callers = 0;
+static void *caller[ALLOC_CHECK_MAX_CALLERS];
+static size_t caller_size[ALLOC_CHECK_MAX_CALLERS];
+
+#if defined(TRACKER_ALLOC_CHECK) && defined(__GLIBC__)
+
+//-------------------------------------------------------------------
+// Called from inside the allocator, so nothing here may allocate.
+// The caller table is claimed slot by slot with a CAS.
+//-------------------------------------------------------------------
+static void note_allocation(size_t size, void *from)
+{
+	int slot;
+
+	if (armed == 0) return;
+
+	__atomic_add_fetch(&count, 1, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&bytes, size, __ATOMIC_RELAXED);
+
+	for (slot = 0; slot < ALLOC_CHECK_MAX_CALLERS; slot++)
+	{
+		void *expected = NULL;
+
+		if (__atomic_load_n(&caller[slot], __ATOMIC_ACQUIRE) == from) return;
+		if (__atomic_compare_exchange_n(&caller[slot], &expected, from, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		{
+			caller_size[slot] = size;
+			__atomic_add_fetch(&callers, 1, __ATOMIC_RELAXED);
+			return;
+		}
+		if (expected == from) return;
+	}
+}
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+
+void *malloc(size_t size)
+{
+	note_allocation(size, __builtin_return_address(0));
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size)
+{
+	note_allocation(n * size, __builtin_return_address(0));
+	return __libc_calloc(n, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+	note_allocation(size, __builtin_return_address(0));
+	return __libc_realloc(ptr, size);
+}
+
+void *memalign(size_t alignment, size_t size)
+{
+	note_allocation(size, __builtin_return_address(0));
+	return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+	note_allocation(size, __builtin_return_address(0));
+	return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **ptr, size_t alignment, size_t size)
+{
+	void *p;
+
+	if ((alignment < sizeof(void *)) || ((alignment & (alignment - 1)) != 0))
+		return EINVAL;
+	note_allocation(size, __builtin_return_address(0));
+	p = __libc_memalign(alignment, size);
+	if (p == NULL) return ENOMEM;
+	*ptr = p;
+	return 0;
+}
+}
+
+int alloc_check_enable(void)
+{
+	enabled = true;
+	return 0;
+}
+
+#else
+
+int alloc_check_enable(void)
+{
+	return -1;
+}
+
+#endif
+
+bool alloc_check_enabled(void)
+{
+	return enabled;
+}
+
+void alloc_check_set_warm(void)
+{
+	__atomic_store_n(&warm, true, __ATOMIC_RELEASE);
+}
+
+bool alloc_check_warm(void)
+{
+	return enabled && __atomic_load_n(&warm, __ATOMIC_ACQUIRE);
+}
+
+void alloc_check_arm(void)
+{
+	if (enabled) armed++;
+}
+
+void alloc_check_disarm(void)
+{
+	if (enabled && (armed > 0)) armed--;
+}
+
+void alloc_check_report(struct AllocReport *report)
+{
+	memset(report, 0, sizeof(*report));
+	report->count = __atomic_load_n(&count, __ATOMIC_RELAXED);
+	report->bytes = __atomic_load_n(&bytes, __ATOMIC_RELAXED);
+	report->callers = __atomic_load_n(&callers, __ATOMIC_RELAXED);
+	if (report->callers > ALLOC_CHECK_MAX_CALLERS) report->callers = ALLOC_CHECK_MAX_CALLERS;
+	for (int slot = 0; slot < report->callers; slot++)
+	{
+		report->caller[slot] = __atomic_load_n(&caller[slot], __ATOMIC_ACQUIRE);
+		report->size[slot] = caller_size[slot];
+	}
+}
@@ -0,0 +1,57 @@
+//-------------------------------------------------------------------
+// alloc_check.h - heap allocation counter for the zero-allocation test
+//
+// The process-wide malloc family is interposed (glibc only, and only
+// in builds with TRACKER_ALLOC_CHECK defined, which none of the
+// shipped macOS configurations are); a call is counted when the
+// calling thread is armed.  The
+// control loop arms itself after warm-up and marks the process warm;
+// from then on listener callbacks arm for their duration, so
+// allocations inside take()/write(), the controllers or the callbacks
+// show up, while discovery before warm-up and DDS's own background
+// threads do not.  Counting is off unless alloc_check_enable() was
+// called.
+//-------------------------------------------------------------------
+#ifndef ALLOC_CHECK_H
+#define ALLOC_CHECK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ALLOC_CHECK_WARMUP_UPDATES 100   // control updates before arming
+#define ALLOC_CHECK_MAX_CALLERS    8
+
+struct AllocReport {
+	uint64_t count;
+	uint64_t bytes;
+	int      callers;                            // distinct callers recorded
+	void    *caller[ALLOC_CHECK_MAX_CALLERS];    // return addresses into the allocating code
+	size_t   size[ALLOC_CHECK_MAX_CALLERS];      // first size seen from each
+};
+
+// Returns -1 where the allocator is not interposed
+int  alloc_check_enable(void);
+bool alloc_check_enabled(void);
+
+// The loop is warmed up; listener scopes count from now on
+void alloc_check_set_warm(void);
+bool alloc_check_warm(void);
+
+// Arm/disarm the calling thread; calls nest
+void alloc_check_arm(void);
+void alloc_check_disarm(void);
+
+void alloc_check_report(struct AllocReport *report);
+
+// Arms the current thread for the lifetime of a listener callback,
+// once the loop is warm
+class AllocCheckScope
+{
+public:
+	AllocCheckScope() : armed(alloc_check_warm()) { if (armed) alloc_check_arm(); }
+	~AllocCheckScope() { if (armed) alloc_check_disarm(); }
+private:
+	bool armed;
+};
+
+#endif
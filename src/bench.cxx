@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "bench.h"
+#include "trajectory.h"
+#include "target_state.h"
+#include "gimbal_head.h"
+
+#define BENCH_TICKS      10000000
+#define BENCH_RETARGET   4          // new controller target every N ticks
+#define BENCH_GATE_SAMPLES 10000000
+#define BENCH_GATE_OUTLIER 16        // every Nth observation is another ball
+#define BENCH_GATE_SIGMAS  4
+#define BENCH_GATE_RING    4096      // power of two
+#define BENCH_LAW_SAMPLES  10000000
+#define BENCH_LAW_INTERVAL_US 33333  // 30 Hz camera
+#define BENCH_LAW_RING     4096      // power of two
+
+struct Bench {
+	const char *name;
+	void (*run)(void);
+};
+
+// Cheap deterministic input so the benchmark measures the tracker code
+static uint32_t bench_random(uint32_t *state)
+{
+	*state = *state * 1664525u + 1013904223u;
+	return *state >> 8;
+}
+
+//-------------------------------------------------------------------
+// Per-tick cost of the trajectory stage, both axes, with the target
+// moving as often as a 60 Hz camera would move it at a 240 Hz tick
+//-------------------------------------------------------------------
+static void bench_trajectory(void)
+{
+	for (int mode = TRAJECTORY_ACCEL; mode <= TRAJECTORY_JERK; mode++)
+	{
+		struct TrajectoryAxis pan;
+		struct TrajectoryAxis tilt;
+		uint32_t seed = 1;
+		int64_t checksum = 0;
+		int64_t start;
+		int64_t elapsed;
+
+		trajectory_init(&pan,  (enum TrajectoryMode) mode, 500, 0, 1000, 240, TRAJ_MAX_VELOCITY, TRAJ_MAX_ACCEL, TRAJ_MAX_JERK);
+		trajectory_init(&tilt, (enum TrajectoryMode) mode, 500, 0, 1000, 240, TRAJ_MAX_VELOCITY, TRAJ_MAX_ACCEL, TRAJ_MAX_JERK);
+
+		start = bench_now_ns();
+		for (int tick = 0; tick < BENCH_TICKS; tick++)
+		{
+			if ((tick % BENCH_RETARGET) == 0)
+			{
+				trajectory_set_target(&pan,  bench_random(&seed) % 1001);
+				trajectory_set_target(&tilt, bench_random(&seed) % 1001);
+			}
+			checksum += trajectory_step(&pan) + trajectory_step(&tilt);
+		}
+		elapsed = bench_now_ns() - start;
+
+		printf("trajectory %-5s %8.1f ns/tick  (%d ticks, checksum %lld)\n",
+				(mode == TRAJECTORY_ACCEL) ? "accel" : "jerk",
+				(double) elapsed / BENCH_TICKS, BENCH_TICKS, (long long) checksum);
+	}
+}
+
+//-------------------------------------------------------------------
+// What the validation gate catches and what it costs: a target
+// sweeping back and forth at 30 Hz with a few servo units of noise,
+// every BENCH_GATE_OUTLIER-th observation somewhere else.  The timed
+// part gates a ring of observations against the settled track.
+//-------------------------------------------------------------------
+static void bench_gate(void)
+{
+	struct TargetTrack target;
+	int32_t pan[BENCH_GATE_RING];
+	int32_t tilt[BENCH_GATE_RING];
+	uint32_t seed = 1;
+	uint64_t outliers = 0;
+	uint64_t outliers_passed = 0;
+	uint64_t targets_rejected = 0;
+	uint64_t passed = 0;
+	int64_t now_us = 0;
+	int64_t start;
+	int64_t elapsed;
+	bool outlier;
+
+	target_init(&target, TARGET_COAST_TIMEOUT_US, TARGET_LOST_TIMEOUT_US);
+	target_set_gate(&target, BENCH_GATE_SIGMAS);
+
+	for (int sample = 0; sample < BENCH_GATE_SAMPLES; sample++)
+	{
+		int slot = sample & (BENCH_GATE_RING - 1);
+
+		now_us += 33333;
+		outlier = (sample % BENCH_GATE_OUTLIER) == BENCH_GATE_OUTLIER - 1;
+		if (outlier)
+		{
+			pan[slot]  = bench_random(&seed) % 1001;
+			tilt[slot] = bench_random(&seed) % 1001;
+		}
+		else
+		{
+			// Triangle wave, 200 frames per sweep across 600 servo units
+			pan[slot]  = 200 + 6 * abs((sample % 200) - 100) + (int32_t) (bench_random(&seed) % 7) - 3;
+			tilt[slot] = 500 + (int32_t) (bench_random(&seed) % 7) - 3;
+		}
+
+		if (target_gate(&target, pan[slot], tilt[slot], now_us))
+		{
+			if (outlier) outliers_passed++;
+			target_observe(&target, pan[slot], tilt[slot], now_us);
+		}
+		else if (!outlier)
+			targets_rejected++;
+		if (outlier) outliers++;
+		target_update(&target, now_us);
+	}
+
+	start = bench_now_ns();
+	for (int sample = 0; sample < BENCH_GATE_SAMPLES; sample++)
+		passed += target_gate(&target, pan[sample & (BENCH_GATE_RING - 1)], tilt[sample & (BENCH_GATE_RING - 1)], now_us);
+	elapsed = bench_now_ns() - start;
+
+	printf("gate %d sigmas %8.1f ns/observation  outliers passed %llu/%llu, target rejected %llu/%llu  (checksum %llu)\n",
+			BENCH_GATE_SIGMAS, (double) elapsed / BENCH_GATE_SAMPLES,
+			(unsigned long long) outliers_passed, (unsigned long long) outliers,
+			(unsigned long long) targets_rejected, (unsigned long long) (BENCH_GATE_SAMPLES - outliers),
+			(unsigned long long) passed);
+}
+
+//-------------------------------------------------------------------
+// Cost per update of each controller law and how well it follows, in
+// a closed loop on the pan axis: the target sweeps a triangle at 180
+// servo units per second and every fourth sweep parks past the end
+// stop for a second, which is what winds an integral up.  The first
+// row is gimbal_update(), the run-time selected PD the tracker used
+// before; the others are fixed at compile time, the fixed-point laws
+// first and then their float versions.  Errors are image
+// pixels, RMS and the worst sample in the second after each return
+// from the stop.
+//-------------------------------------------------------------------
+template <class L>
+struct BenchLawAxis : PanAxis {
+	typedef L Law;
+};
+
+static void bench_law_trace(int32_t *target)
+{
+	for (int sample = 0; sample < BENCH_LAW_RING; sample++)
+	{
+		int sweep = (sample / 100) % 4;
+		int phase = sample % 100;
+
+		// 100 samples a sweep; sweep 3 goes to the stop, waits and comes back
+		if (sweep == 3)
+			target[sample] = (phase < 30) ? PIXY_RCS_MAX_POS + 150 : 800 - 6 * (phase - 30) * 100 / 70;
+		else
+			target[sample] = (sweep == 1) ? 800 - 6 * phase : 200 + 6 * phase;
+	}
+}
+
+template <class Axis>
+static void bench_law_run(const char *name, void (*update)(struct Gimbal *, int32_t, int32_t))
+{
+	static int32_t target[BENCH_LAW_RING];
+	struct Gimbal gimbal;
+	double squares = 0;
+	int32_t worst = 0;
+	int32_t error;
+	int64_t start;
+	int64_t elapsed;
+
+	bench_law_trace(target);
+	gimbal_axis_init<Axis>(&gimbal);
+
+	start = bench_now_ns();
+	for (int sample = 0; sample < BENCH_LAW_SAMPLES; sample++)
+	{
+		int slot = sample & (BENCH_LAW_RING - 1);
+
+		error = gimbal_axis_to_error<Axis>(target[slot] - gimbal.position);
+		if (update != NULL)
+			update(&gimbal, error, BENCH_LAW_INTERVAL_US);
+		else
+			gimbal_axis_update<Axis>(&gimbal, error, BENCH_LAW_INTERVAL_US);
+		squares += (double) error * error;
+		if (((slot % 400) >= 340) && ((slot % 400) < 370) && (abs(error) > worst))
+			worst = abs(error);
+	}
+	elapsed = bench_now_ns() - start;
+
+	printf("law %-12s %6.1f ns/update  rms %6.2f px, after the stop %4d px\n", name,
+			(double) elapsed / BENCH_LAW_SAMPLES, sqrt(squares / BENCH_LAW_SAMPLES), worst);
+}
+
+static void bench_law(void)
+{
+	bench_law_run<PanAxis>("pd (update)", gimbal_update);
+	bench_law_run<BenchLawAxis<PLaw> >("p", NULL);
+	bench_law_run<BenchLawAxis<PdLaw> >("pd", NULL);
+	bench_law_run<BenchLawAxis<PidLaw> >("pid", NULL);
+	bench_law_run<BenchLawAxis<PidAntiWindupLaw> >("pid-aw", NULL);
+	bench_law_run<BenchLawAxis<FloatPLaw> >("p-float", NULL);
+	bench_law_run<BenchLawAxis<FloatPdLaw> >("pd-float", NULL);
+	bench_law_run<BenchLawAxis<FloatPidLaw> >("pid-float", NULL);
+	bench_law_run<BenchLawAxis<FloatPidAntiWindupLaw> >("pid-aw-float", NULL);
+}
+
+static const struct Bench benches[] = {
+	{ "trajectory", bench_trajectory },
+	{ "gate",       bench_gate },
+	{ "law",        bench_law }
+};
+
+int bench_run(const char *name)
+{
+	bool found = false;
+
+	for (unsigned int b = 0; b < sizeof(benches) / sizeof(benches[0]); b++)
+	{
+		if ((strcmp(name, "all") == 0) || (strcmp(name, benches[b].name) == 0))
+		{
+			benches[b].run();
+			found = true;
+		}
+	}
+	if (!found)
+	{
+		fprintf(stderr, "unknown benchmark %s:", name);
+		for (unsigned int b = 0; b < sizeof(benches) / sizeof(benches[0]); b++)
+			fprintf(stderr, " %s", benches[b].name);
+		fprintf(stderr, " all\n");
+		return -1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,25 @@
+//-------------------------------------------------------------------
+// bench.h - offline micro-benchmarks, run with "pixytracker -bench <name>"
+//
+// Benchmarks exercise the DDS-free tracker modules on synthetic input
+// so hot-path costs can be compared between builds and boards.
+//-------------------------------------------------------------------
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <time.h>
+
+static inline int64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// Runs the named benchmark ("all" runs every one); returns 0 on
+// success, -1 for an unknown name.
+int bench_run(const char *name);
+
+#endif
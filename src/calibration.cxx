@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "calibration.h"
+
+#define CAL_DEGREE 3
+
+static void axis_linear(struct AxisCalibration *axis, int32_t center, int32_t sign)
+{
+	for (int i = 0; i < CAL_LUT_SIZE; i++)
+		axis->lut[i] = sign * ((i << CAL_SPACING_BITS) - center) * (1 << CAL_FRACTION_BITS);
+}
+
+void calibration_identity(struct Calibration *cal, int32_t x_center, int32_t y_center)
+{
+	axis_linear(&cal->pan, x_center, -1);
+	axis_linear(&cal->tilt, y_center, 1);
+}
+
+static int parse_axis(const char *text, struct AxisCalibration *axis)
+{
+	char *end;
+
+	for (int i = 0; i < CAL_LUT_SIZE; i++)
+	{
+		axis->lut[i] = (int32_t) strtol(text, &end, 10);
+		if (end == text) return -1;
+		text = end;
+	}
+	return 0;
+}
+
+int calibration_load(struct Calibration *cal, const char *path)
+{
+	FILE *fp;
+	char line[512];
+	int found = 0;
+	int status = 0;
+
+	fp = fopen(path, "r");
+	if (fp == NULL)
+	{
+		fprintf(stderr, "calibration %s: cannot open\n", path);
+		return -1;
+	}
+	while ((status == 0) && (fgets(line, sizeof(line), fp) != NULL))
+	{
+		if (strncmp(line, "pan ", 4) == 0)
+		{
+			status = parse_axis(line + 4, &cal->pan);
+			found |= 1;
+		}
+		else if (strncmp(line, "tilt ", 5) == 0)
+		{
+			status = parse_axis(line + 5, &cal->tilt);
+			found |= 2;
+		}
+	}
+	fclose(fp);
+	if ((status != 0) || (found != 3))
+	{
+		fprintf(stderr, "calibration %s: bad format\n", path);
+		return -1;
+	}
+
+	return 0;
+}
+
+int calibration_save(const struct Calibration *cal, const char *path)
+{
+	FILE *fp;
+
+	fp = fopen(path, "w");
+	if (fp == NULL)
+	{
+		fprintf(stderr, "calibration %s: cannot create\n", path);
+		return -1;
+	}
+	fprintf(fp, "# pixytracker calibration: tracking error in 1/%d pixel at pixel 0, %d, %d ...\n",
+			1 << CAL_FRACTION_BITS, 1 << CAL_SPACING_BITS, 2 << CAL_SPACING_BITS);
+	fprintf(fp, "pan");
+	for (int i = 0; i < CAL_LUT_SIZE; i++)
+		fprintf(fp, " %d", cal->pan.lut[i]);
+	fprintf(fp, "\ntilt");
+	for (int i = 0; i < CAL_LUT_SIZE; i++)
+		fprintf(fp, " %d", cal->tilt.lut[i]);
+	fprintf(fp, "\n");
+	fclose(fp);
+
+	return 0;
+}
+
+//-------------------------------------------------------------------
+// Least-squares cubic through the normal equations.  Pixels are
+// scaled to 0..1 first to keep the system well conditioned.
+//-------------------------------------------------------------------
+int calibration_fit_axis(struct AxisCalibration *axis, const double *pixel, const double *angle, int count,
+		int32_t servo_per_pixel_q10)
+{
+	const int n = CAL_DEGREE + 1;
+	double a[CAL_DEGREE + 1][CAL_DEGREE + 2];
+	double coef[CAL_DEGREE + 1];
+	const double scale = 1.0 / CAL_PIXEL_MAX;
+
+	if (count < n) return -1;
+
+	memset(a, 0, sizeof(a));
+	for (int k = 0; k < count; k++)
+	{
+		double u = pixel[k] * scale;
+		double power[2 * CAL_DEGREE + 1];
+
+		power[0] = 1.0;
+		for (int p = 1; p <= 2 * CAL_DEGREE; p++)
+			power[p] = power[p - 1] * u;
+		for (int r = 0; r < n; r++)
+		{
+			for (int c = 0; c < n; c++)
+				a[r][c] += power[r + c];
+			a[r][n] += power[r] * angle[k];
+		}
+	}
+
+	// Gaussian elimination with partial pivoting
+	for (int col = 0; col < n; col++)
+	{
+		int pivot = col;
+		for (int r = col + 1; r < n; r++)
+		{
+			if (fabs(a[r][col]) > fabs(a[pivot][col])) pivot = r;
+		}
+		if (fabs(a[pivot][col]) < 1e-12) return -1;
+		if (pivot != col)
+		{
+			for (int c = 0; c <= n; c++)
+			{
+				double t = a[col][c];
+				a[col][c] = a[pivot][c];
+				a[pivot][c] = t;
+			}
+		}
+		for (int r = col + 1; r < n; r++)
+		{
+			double f = a[r][col] / a[col][col];
+			for (int c = col; c <= n; c++)
+				a[r][c] -= f * a[col][c];
+		}
+	}
+	for (int r = n - 1; r >= 0; r--)
+	{
+		double sum = a[r][n];
+		for (int c = r + 1; c < n; c++)
+			sum -= a[r][c] * coef[c];
+		coef[r] = sum / a[r][r];
+	}
+
+	// Sample the fit: angle in servo units -> error in 1/16 linear pixels
+	for (int i = 0; i < CAL_LUT_SIZE; i++)
+	{
+		double u = (double) (i << CAL_SPACING_BITS) * scale;
+		double fit = coef[0] + u * (coef[1] + u * (coef[2] + u * coef[3]));
+		axis->lut[i] = (int32_t) lround(fit * 1024.0 / servo_per_pixel_q10 * (1 << CAL_FRACTION_BITS));
+	}
+
+	return 0;
+}
+
+void calibration_sweep_init(struct CalibrationSweep *sweep)
+{
+	memset(sweep, 0, sizeof(*sweep));
+	sweep->phase = CAL_CENTERING;
+}
+
+bool calibration_sweep_centered(struct CalibrationSweep *sweep, int32_t pan_error, int32_t tilt_error,
+		int32_t pan, int32_t tilt, int64_t now_us)
+{
+	if (sweep->phase != CAL_CENTERING) return false;
+
+	if ((abs(pan_error) <= CAL_CENTERED_PIXELS) && (abs(tilt_error) <= CAL_CENTERED_PIXELS))
+		sweep->centered++;
+	else
+		sweep->centered = 0;
+	if (sweep->centered < CAL_CENTERED_COUNT) return false;
+
+	sweep->center_pan = pan;
+	sweep->center_tilt = tilt;
+	sweep->phase = CAL_SWEEP_PAN;
+	sweep->step = -1;
+	sweep->count = 0;
+	sweep->step_start_us = now_us - CAL_STEP_TIMEOUT_US;  // first update moves to step 0
+	return true;
+}
+
+static int32_t sweep_offset(int step)
+{
+	return -CAL_SWEEP_SPAN + step * CAL_SWEEP_STEP;
+}
+
+static void sweep_command(const struct CalibrationSweep *sweep, int32_t *pan, int32_t *tilt)
+{
+	*pan = sweep->center_pan;
+	*tilt = sweep->center_tilt;
+	if (sweep->step >= CAL_SWEEP_POINTS) return;
+	if (sweep->phase == CAL_SWEEP_PAN)
+		*pan += sweep_offset(sweep->step);
+	else if (sweep->phase == CAL_SWEEP_TILT)
+		*tilt += sweep_offset(sweep->step);
+}
+
+bool calibration_sweep_update(struct CalibrationSweep *sweep, bool have_sample, int32_t x, int32_t y,
+		int64_t now_us, int32_t *pan, int32_t *tilt, int32_t pan_servo_per_pixel_q10, int32_t tilt_servo_per_pixel_q10)
+{
+	bool step_done = false;
+
+	if ((sweep->phase != CAL_SWEEP_PAN) && (sweep->phase != CAL_SWEEP_TILT)) return false;
+
+	if (have_sample && (now_us - sweep->step_start_us >= CAL_SETTLE_US) && (sweep->step >= 0))
+	{
+		sweep->pixel_sum += (sweep->phase == CAL_SWEEP_PAN) ? x : y;
+		if (++sweep->averaged >= CAL_AVERAGE)
+		{
+			sweep->pixel[sweep->count] = (double) sweep->pixel_sum / sweep->averaged;
+			sweep->angle[sweep->count] = -sweep_offset(sweep->step);
+			sweep->count++;
+			step_done = true;
+		}
+	}
+	if (now_us - sweep->step_start_us >= CAL_STEP_TIMEOUT_US)
+		step_done = true;
+	if (!step_done) return false;
+
+	// Next offset, or finish this axis
+	sweep->step++;
+	sweep->averaged = 0;
+	sweep->pixel_sum = 0;
+	sweep->step_start_us = now_us;
+	if (sweep->step >= CAL_SWEEP_POINTS)
+	{
+		if (sweep->phase == CAL_SWEEP_PAN)
+		{
+			if (calibration_fit_axis(&sweep->result.pan, sweep->pixel, sweep->angle, sweep->count, pan_servo_per_pixel_q10) != 0)
+			{
+				fprintf(stderr, "calibration: pan fit failed (%d points)\n", sweep->count);
+				sweep->failed = true;
+			}
+			sweep->phase = CAL_SWEEP_TILT;
+			sweep->step = 0;
+			sweep->count = 0;
+		}
+		else
+		{
+			if (calibration_fit_axis(&sweep->result.tilt, sweep->pixel, sweep->angle, sweep->count, tilt_servo_per_pixel_q10) != 0)
+			{
+				fprintf(stderr, "calibration: tilt fit failed (%d points)\n", sweep->count);
+				sweep->failed = true;
+			}
+			sweep->phase = CAL_DONE;
+		}
+	}
+
+	sweep_command(sweep, pan, tilt);
+	return true;
+}
@@ -0,0 +1,115 @@
+//-------------------------------------------------------------------
+// calibration.h - calibrated image-to-error mapping
+//
+// Each axis has a lookup table from image coordinate to tracking
+// error, in pixels of an ideal linear lens (1/16 pixel resolution).
+// Entries are 16 pixels apart so a lookup is one table read, a
+// subtract, a multiply and a shift.  The identity table reproduces
+// PIXY_X_CENTER - x / y - PIXY_Y_CENTER exactly.
+//
+// Calibration: with a stationary ball centred, the gimbal is stepped
+// across each axis.  At servo offset d the ball is seen at pixel p,
+// so the true angle of p from boresight is -d servo units.  A cubic
+// least-squares fit of angle against pixel captures lens distortion
+// and mount offset and is sampled into the table.
+//-------------------------------------------------------------------
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <stdint.h>
+
+#define CAL_FRACTION_BITS 4
+#define CAL_SPACING_BITS  4
+#define CAL_LUT_SIZE      17     // covers pixels 0..255
+#define CAL_PIXEL_MAX     ((1 << CAL_SPACING_BITS) * (CAL_LUT_SIZE - 1) - 1)
+
+struct AxisCalibration {
+	int32_t lut[CAL_LUT_SIZE];
+};
+
+struct Calibration {
+	struct AxisCalibration pan;
+	struct AxisCalibration tilt;
+};
+
+// Tracking error for an image coordinate, in 1/16 pixel
+static inline int32_t calibration_map(const struct AxisCalibration *axis, int32_t pixel)
+{
+	int32_t index;
+	int32_t fraction;
+	const int32_t *entry;
+
+	if (pixel < 0) pixel = 0;
+	else if (pixel > CAL_PIXEL_MAX) pixel = CAL_PIXEL_MAX;
+
+	index = pixel >> CAL_SPACING_BITS;
+	fraction = pixel & ((1 << CAL_SPACING_BITS) - 1);
+	entry = &axis->lut[index];
+
+	return entry[0] + (((entry[1] - entry[0]) * fraction) >> CAL_SPACING_BITS);
+}
+
+// Linear tables: pan error = x_center - x, tilt error = y - y_center
+void calibration_identity(struct Calibration *cal, int32_t x_center, int32_t y_center);
+
+// Text file: a "pan" and a "tilt" line of CAL_LUT_SIZE entries each
+int calibration_load(struct Calibration *cal, const char *path);
+int calibration_save(const struct Calibration *cal, const char *path);
+
+// Fits angle (servo units) = cubic(pixel) and fills the table with the
+// equivalent linear-lens error, using servo_per_pixel_q10 as the
+// nominal lens scale.  Returns -1 with fewer than 4 points.
+int calibration_fit_axis(struct AxisCalibration *axis, const double *pixel, const double *angle, int count,
+		int32_t servo_per_pixel_q10);
+
+//-------------------------------------------------------------------
+// Calibration sweep, driven from the control loop
+//-------------------------------------------------------------------
+#define CAL_SWEEP_SPAN     180      // servo units either side of centre
+#define CAL_SWEEP_STEP     30
+#define CAL_SWEEP_POINTS   (2 * CAL_SWEEP_SPAN / CAL_SWEEP_STEP + 1)
+#define CAL_SETTLE_US      400000   // ignore samples while the servo moves
+#define CAL_STEP_TIMEOUT_US 2000000 // ball not seen at this offset: skip it
+#define CAL_AVERAGE        10       // samples averaged per offset
+#define CAL_CENTERED_COUNT 30       // observations within CAL_CENTERED_PIXELS
+#define CAL_CENTERED_PIXELS 2
+
+enum CalibrationPhase {
+	CAL_CENTERING,   // normal tracking until the ball sits still in the centre
+	CAL_SWEEP_PAN,
+	CAL_SWEEP_TILT,
+	CAL_DONE
+};
+
+struct CalibrationSweep {
+	enum CalibrationPhase phase;
+	int centered;
+	int32_t center_pan;
+	int32_t center_tilt;
+	int step;
+	int64_t step_start_us;
+	int averaged;
+	int64_t pixel_sum;
+	int count;
+	double pixel[CAL_SWEEP_POINTS];
+	double angle[CAL_SWEEP_POINTS];
+	struct Calibration result;
+	bool failed;      // too few points on an axis; result unusable
+};
+
+void calibration_sweep_init(struct CalibrationSweep *sweep);
+
+// While CENTERING, reports the controller's error for each applied
+// observation and returns true once the ball has been still long
+// enough; pan/tilt is the centred gimbal position.
+bool calibration_sweep_centered(struct CalibrationSweep *sweep, int32_t pan_error, int32_t tilt_error,
+		int32_t pan, int32_t tilt, int64_t now_us);
+
+// During the sweeps, call every loop pass with the latest observation
+// (have_sample false if none).  Returns true when *pan/*tilt hold a
+// new servo command.  Moves to CAL_DONE once both axes are fitted;
+// result is valid unless failed is set.
+bool calibration_sweep_update(struct CalibrationSweep *sweep, bool have_sample, int32_t x, int32_t y,
+		int64_t now_us, int32_t *pan, int32_t *tilt, int32_t pan_servo_per_pixel_q10, int32_t tilt_servo_per_pixel_q10);
+
+#endif
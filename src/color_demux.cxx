@@ -0,0 +1,97 @@
+#include <string.h>
+#include "tracker_time.h"
+#include "color_demux.h"
+
+int color_intern(const char *color)
+{
+	for (int c = 0; c < NUM_SIGS; c++)
+		if ((color[0] == sigName[c][0]) && (strcmp(color, sigName[c]) == 0))
+			return c;
+	return -1;
+}
+
+void color_demux_init(struct ColorDemux *demux, ShapeTypeExtendedDataReader *reader, uint32_t wanted)
+{
+	demux->reader = reader;
+	demux->wanted = wanted;
+	memset(demux->queue, 0, sizeof(demux->queue));
+	demux->instances = 0;
+	demux->taken = 0;
+	demux->unwanted = 0;
+}
+
+//-------------------------------------------------------------------
+// Instance handle first; the color string (NULL for samples without
+// data) only for an instance not seen yet
+//-------------------------------------------------------------------
+static int route(struct ColorDemux *demux, const DDS_InstanceHandle_t &handle, const char *color)
+{
+	int id;
+
+	for (int i = 0; i < demux->instances; i++)
+		if (DDS_InstanceHandle_equals(&demux->instance[i].handle, &handle))
+			return demux->instance[i].color;
+
+	if (color == NULL) return -1;
+	id = color_intern(color);
+	if (demux->instances < DEMUX_MAX_INSTANCES)
+	{
+		demux->instance[demux->instances].handle = handle;
+		demux->instance[demux->instances].color = id;
+		demux->instances++;
+	}
+
+	return id;
+}
+
+static void push(struct DemuxQueue *queue, const ShapeTypeExtended &shape, const DDS_SampleInfo &info)
+{
+	struct DemuxSample *sample;
+
+	if (queue->tail - queue->head == DEMUX_QUEUE_SIZE)
+	{
+		queue->head++;
+		queue->dropped++;
+	}
+	sample = &queue->sample[queue->tail++ & (DEMUX_QUEUE_SIZE - 1)];
+	sample->valid = (info.valid_data == RTI_TRUE);
+	sample->instance_state = info.instance_state;
+	sample->source_us = DDS_TIME_TO_US(info.source_timestamp);
+	sample->publication = info.publication_handle;
+	if (sample->valid)
+	{
+		sample->x = shape.x;
+		sample->y = shape.y;
+		sample->size = shape.shapesize;
+	}
+}
+
+int color_demux_poll(struct ColorDemux *demux)
+{
+	DDS_ReturnCode_t retcode;
+	int queued = 0;
+	int color;
+
+	retcode = demux->reader->take(demux->data, demux->info, DEMUX_TAKE_BATCH,
+			DDS_ANY_SAMPLE_STATE, DDS_ANY_VIEW_STATE, DDS_ANY_INSTANCE_STATE);
+	if (retcode == DDS_RETCODE_NO_DATA) return 0;
+	if (retcode != DDS_RETCODE_OK) return -1;
+
+	for (int i = 0; i < demux->data.length(); i++)
+	{
+		const DDS_SampleInfo &info = demux->info[i];
+
+		demux->taken++;
+		color = route(demux, info.instance_handle, (info.valid_data == RTI_TRUE) ? demux->data[i].color : NULL);
+		if ((color < 0) || ((demux->wanted & (1u << color)) == 0))
+		{
+			demux->unwanted++;
+			continue;
+		}
+		push(&demux->queue[color], demux->data[i], info);
+		queued++;
+	}
+	demux->reader->return_loan(demux->data, demux->info);
+
+	return queued;
+}
@@ -0,0 +1,86 @@
+//-------------------------------------------------------------------
+// color_demux.h - one unfiltered Circle reader feeding per-color queues
+//
+// The tracker subscribes through a "color MATCH" content filter, so
+// following N colors from one process takes N filtered readers, each
+// with its own reader state and a filter evaluation per sample.
+// ColorDemux takes from a single unfiltered reader instead, in loaned
+// batches, and routes each sample by color into a small ring per
+// color.  The color string is interned to its sigName index once per
+// instance; after that the instance handle is enough, which also
+// routes the disposed / no-writers samples that carry no data.
+//
+// Polling and popping happen on one thread, like the tracker loop.  A
+// full queue drops its oldest sample: the newest observation is the
+// one worth acting on.
+//
+// track() does not use it yet; it still follows its color through the
+// filtered reader.  For now ColorDemux is the demux side of
+// -demux-bench (demux_bench.h), which measures it against the filtered
+// readers before a multi-color tracker is built on it.
+//-------------------------------------------------------------------
+#ifndef COLOR_DEMUX_H
+#define COLOR_DEMUX_H
+
+#include <stdint.h>
+#include "ShapeType.h"
+#include "ShapeTypeSupport.h"
+#include "tracker.h"
+
+#define DEMUX_QUEUE_SIZE     16      // per color, power of two
+#define DEMUX_TAKE_BATCH     64
+#define DEMUX_MAX_INSTANCES  16      // cached instance handle -> color
+
+struct DemuxSample {
+	int32_t x;
+	int32_t y;
+	int32_t size;
+	bool    valid;                   // false: only the instance state changed
+	DDS_InstanceStateKind instance_state;
+	int64_t source_us;
+	DDS_InstanceHandle_t publication;
+};
+
+struct DemuxQueue {
+	struct DemuxSample sample[DEMUX_QUEUE_SIZE];
+	uint32_t head;                   // next to pop
+	uint32_t tail;                   // next to push
+	uint64_t dropped;
+} __attribute__((aligned(64)));
+
+struct DemuxInstance {
+	DDS_InstanceHandle_t handle;
+	int color;
+};
+
+struct ColorDemux {
+	ShapeTypeExtendedDataReader *reader;
+	uint32_t wanted;                 // bit per sigName index
+	struct DemuxQueue queue[NUM_SIGS];
+	struct DemuxInstance instance[DEMUX_MAX_INSTANCES];
+	int instances;
+	uint64_t taken;
+	uint64_t unwanted;               // colors not asked for, or not in sigName
+	ShapeTypeExtendedSeq data;
+	DDS_SampleInfoSeq info;
+};
+
+// sigName index of a color, or -1
+int color_intern(const char *color);
+
+void color_demux_init(struct ColorDemux *demux, ShapeTypeExtendedDataReader *reader, uint32_t wanted);
+
+// Takes one batch and routes it.  Returns the samples queued, or -1
+// on a reader error.
+int color_demux_poll(struct ColorDemux *demux);
+
+static inline bool color_demux_pop(struct ColorDemux *demux, int color, struct DemuxSample *sample)
+{
+	struct DemuxQueue *queue = &demux->queue[color];
+
+	if (queue->head == queue->tail) return false;
+	*sample = queue->sample[queue->head++ & (DEMUX_QUEUE_SIZE - 1)];
+	return true;
+}
+
+#endif
@@ -0,0 +1,130 @@
+#include <stddef.h>
+#include "control.h"
+
+void control_init(struct ControlCore *core, int32_t servo_hz, int64_t coast_timeout_us, int64_t lost_timeout_us,
+		int32_t gate_sigmas)
+{
+	gimbal_head_init(&core->head);
+	target_init(&core->target, coast_timeout_us, lost_timeout_us);
+	target_set_gate(&core->target, gate_sigmas);
+	core->search_pattern = NULL;
+	core->state = TARGET_LOST;
+	core->searching = false;
+	core->search_start_us = 0;
+	core->servo_period_us = 1000000 / servo_hz;
+	core->next_coast_us = 0;
+	core->last_source_us = 0;
+	for (int a = 0; a < PanTiltHead::AXES; a++)
+		core->error[a] = 0;
+}
+
+bool control_measure(struct ControlCore *core, int32_t x, int32_t y, int64_t now_us, bool gate)
+{
+	int32_t observed[PanTiltHead::AXES];
+
+	// The calibration table turns image coordinates into the error an
+	// ideal linear lens would give
+	core->error[GIMBAL_PAN]  = calibration_map(&core->calibration.pan,  x) >> CAL_FRACTION_BITS;
+	core->error[GIMBAL_TILT] = calibration_map(&core->calibration.tilt, y) >> CAL_FRACTION_BITS;
+	gimbal_head_to_servo(&core->head, core->error, observed);
+
+	// Another object of the same color far from where the target
+	// should be must not yank the gimbal
+	if (gate && !target_gate(&core->target, observed[GIMBAL_PAN], observed[GIMBAL_TILT], now_us))
+		return false;
+	target_observe(&core->target, observed[GIMBAL_PAN], observed[GIMBAL_TILT], now_us);
+
+	return true;
+}
+
+enum ControlResult control_observe(struct ControlCore *core, int32_t x, int32_t y, int64_t source_us, int64_t now_us)
+{
+	int32_t interval_us;
+	unsigned int held;
+
+	if (!control_measure(core, x, y, now_us, true))
+		return CONTROL_GATED;
+
+	interval_us = gimbal_source_interval(source_us, core->last_source_us);
+	core->last_source_us = source_us;
+	held = gimbal_head_track(&core->head, core->error, interval_us, source_us);
+	core->next_coast_us = now_us + core->servo_period_us;
+
+	return (held == GimbalHead<PanTiltHead>::ALL_HELD) ? CONTROL_HELD : CONTROL_WRITE;
+}
+
+void control_clear_error(struct ControlCore *core)
+{
+	for (int a = 0; a < PanTiltHead::AXES; a++)
+		core->head.axis[a].previous_error = GIMBAL_NO_ERROR;
+}
+
+unsigned int control_tick(struct ControlCore *core, int64_t now_us)
+{
+	struct Gimbal *pan  = &core->head.axis[GIMBAL_PAN];
+	struct Gimbal *tilt = &core->head.axis[GIMBAL_TILT];
+	enum TargetState state = target_update(&core->target, now_us);
+	int32_t predicted[PanTiltHead::AXES];
+	int32_t error[PanTiltHead::AXES];
+	unsigned int events = 0;
+
+	if (state != TARGET_TRACKING)
+		gimbal_head_reset_integral(&core->head);
+	if (state != core->state)
+	{
+		events |= CONTROL_TICK_STATE;
+		if (state == TARGET_LOST)
+		{
+			// Whatever is seen next starts a new interval and error history
+			core->last_source_us = 0;
+			control_clear_error(core);
+			if (core->search_pattern != NULL)
+			{
+				search_begin(&core->search_scan, core->search_pattern, pan->position, tilt->position,
+						core->target.pan.velocity, core->target.tilt.velocity);
+				core->searching = true;
+				core->search_start_us = now_us;
+			}
+		}
+		else if (core->searching)
+		{
+			// First valid observation ends the scan; closed loop takes over
+			events |= CONTROL_TICK_REACQUIRED;
+			core->searching = false;
+		}
+		core->state = state;
+	}
+
+	// While coasting, keep steering toward where the ball should be
+	// now, at the servo rate, so reacquisition starts near it
+	if ((state == TARGET_COASTING) && (now_us >= core->next_coast_us))
+	{
+		target_predict(&core->target, now_us, &predicted[GIMBAL_PAN], &predicted[GIMBAL_TILT]);
+		gimbal_head_to_error(&core->head, predicted, error);
+		gimbal_head_update(&core->head, error, (int32_t) core->servo_period_us, 0);
+		core->next_coast_us = now_us + core->servo_period_us;
+		events |= CONTROL_TICK_WRITE;
+	}
+
+	// Lost: step through the scan table open loop at the servo rate
+	if (core->searching && (now_us >= core->next_coast_us))
+	{
+		search_next(&core->search_scan, &pan->position, &tilt->position);
+		// Don't let the first observation differentiate against a stale error
+		control_clear_error(core);
+		core->next_coast_us = now_us + core->servo_period_us;
+		events |= CONTROL_TICK_WRITE;
+	}
+
+	return events;
+}
+
+int64_t control_next_tick_us(const struct ControlCore *core)
+{
+	int64_t next_us = target_next_change_us(&core->target);
+
+	if (((core->target.state == TARGET_COASTING) || core->searching) && (core->next_coast_us < next_us))
+		next_us = core->next_coast_us;
+
+	return next_us;
+}
@@ -0,0 +1,79 @@
+//-------------------------------------------------------------------
+// control.h - the tracker's control step, without DDS
+//
+// What track() does with an applied observation, and on every pass
+// of its loop, in one place so -replay runs the same code:
+//
+//   control_observe - calibration table, validation gate, target
+//                     filter, then the gimbal laws at the interval
+//                     since the previous observation's source time
+//   control_tick    - target state timeouts; coasting toward the
+//                     prediction and the search scan, at the servo
+//                     rate from the last command
+//
+// The caller owns the clock (CLOCK_MONOTONIC in track(), a virtual
+// clock in -replay) and the output: a step that moves the head says
+// so, and the caller writes the head's position.  track() polls
+// control_tick() continuously; a caller that only wakes up for
+// events asks control_next_tick_us() when the next one is due.
+//-------------------------------------------------------------------
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <stdint.h>
+#include "calibration.h"
+#include "gimbal_head.h"
+#include "search_pattern.h"
+#include "target_state.h"
+
+enum ControlResult {
+	CONTROL_GATED,      // the validation gate rejected it; nothing changed
+	CONTROL_HELD,       // both axes in their dead band; nothing to write
+	CONTROL_WRITE       // write the head's position
+};
+
+// control_tick() events
+#define CONTROL_TICK_STATE      0x1   // core->state changed
+#define CONTROL_TICK_REACQUIRED 0x2   // the search scan ended at core->search_start_us
+#define CONTROL_TICK_WRITE      0x4   // coast or search step; write the head's position
+
+struct ControlCore {
+	GimbalHead<PanTiltHead> head;
+	struct TargetTrack target;
+	struct Calibration calibration;
+	const struct SearchPattern *search_pattern;  // NULL: hold still when lost
+	struct SearchScan search_scan;
+	enum TargetState state;                      // as of the last control_tick()
+	bool searching;
+	int64_t search_start_us;
+	int64_t servo_period_us;
+	int64_t next_coast_us;                       // next coast or search step
+	int64_t last_source_us;                      // 0: next interval unknown
+	int32_t error[PanTiltHead::AXES];            // of the last measured observation
+};
+
+// Head at its defaults, target lost, no search.  The caller sets the
+// calibration and any per-axis settings afterwards.
+void control_init(struct ControlCore *core, int32_t servo_hz, int64_t coast_timeout_us, int64_t lost_timeout_us,
+		int32_t gate_sigmas);
+
+// Calibration and the target filter only, for an observation that
+// must not move the gimbal (the calibration sweep).  With gate, false
+// if the validation gate rejected it.
+bool control_measure(struct ControlCore *core, int32_t x, int32_t y, int64_t now_us, bool gate);
+
+// An applied observation: measured, gated, then both laws
+enum ControlResult control_observe(struct ControlCore *core, int32_t x, int32_t y, int64_t source_us, int64_t now_us);
+
+// Drops the error history, e.g. after the head was moved from outside
+void control_clear_error(struct ControlCore *core);
+
+// Advances the target state to now_us and takes a coast or search
+// step if one is due; returns CONTROL_TICK_* events
+unsigned int control_tick(struct ControlCore *core, int64_t now_us);
+
+// The first time control_tick() would do anything: a state timeout
+// or a coast / search step.  INT64_MAX when it would not.
+int64_t control_next_tick_us(const struct ControlCore *core);
+
+#endif
@@ -0,0 +1,281 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "ShapeType.h"
+#include "ShapeTypeSupport.h"
+#include "tracker_time.h"
+#include "color_demux.h"
+#include "demux_bench.h"
+
+#include "ndds/ndds_cpp.h"
+
+#define DEMUX_BENCH_DRAIN_MS 100
+
+struct BenchWriters {
+	DDSDomainParticipant *participant;
+	ShapeTypeExtendedDataWriter *writer[DEMUX_BENCH_MAX_PUBLISHERS];
+	int count;
+	ShapeTypeExtended shape;
+	char color[128 + 1];
+};
+
+struct DemuxRun {
+	uint64_t delivered;
+	int64_t  elapsed_us;
+	int64_t  cpu_us;
+	long     resident_kb;       // -1 where /proc is not available
+};
+
+static long resident_kb(void)
+{
+	FILE *fp = fopen("/proc/self/statm", "r");
+	long size;
+	long resident = -1;
+
+	if (fp == NULL) return -1;
+	if (fscanf(fp, "%ld %ld", &size, &resident) != 2)
+		resident = -1;
+	fclose(fp);
+
+	return (resident < 0) ? -1 : resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static void delete_participant(DDSDomainParticipant *participant)
+{
+	if (participant == NULL) return;
+	participant->delete_contained_entities();
+	DDSTheParticipantFactory->delete_participant(participant);
+}
+
+static DDSTopic *circle_topic(DDSDomainParticipant *participant)
+{
+	ShapeTypeExtendedTypeSupport::register_type(participant, ShapeTypeExtendedTypeSupport::get_type_name());
+	return participant->create_topic("Circle", ShapeTypeExtendedTypeSupport::get_type_name(),
+			DDS_TOPIC_QOS_DEFAULT, NULL, DDS_STATUS_MASK_NONE);
+}
+
+static int writers_open(struct BenchWriters *writers, int domain_id, const struct TrackerConfig *config, int count)
+{
+	DDSTopic *topic;
+	DDSPublisher *publisher;
+
+	writers->count = 0;
+	writers->participant = transport_create_participant(domain_id, TRACKER_QOS_LIBRARY, config->qos_profile, config->transport);
+	if (writers->participant == NULL)
+	{
+		fprintf(stderr, "demux bench: create writer participant error\n");
+		return -1;
+	}
+	topic = circle_topic(writers->participant);
+	publisher = writers->participant->create_publisher(DDS_PUBLISHER_QOS_DEFAULT, NULL, DDS_STATUS_MASK_NONE);
+	if ((topic == NULL) || (publisher == NULL))
+	{
+		fprintf(stderr, "demux bench: writer topic/publisher error\n");
+		return -1;
+	}
+	for (; writers->count < count; writers->count++)
+	{
+		writers->writer[writers->count] = ShapeTypeExtendedDataWriter::narrow(publisher->create_datawriter_with_profile(
+				topic, TRACKER_QOS_LIBRARY, config->qos_profile, NULL, DDS_STATUS_MASK_NONE));
+		if (writers->writer[writers->count] == NULL)
+		{
+			fprintf(stderr, "demux bench: create writer %d error\n", writers->count);
+			return -1;
+		}
+	}
+
+	writers->shape.color = writers->color;
+	ShapeTypeExtended_initialize_ex(&writers->shape, RTI_TRUE, RTI_FALSE);
+	writers->shape.shapesize = 30;
+
+	return 0;
+}
+
+// One frame: every publisher writes every color
+static void writers_frame(struct BenchWriters *writers, uint64_t frame)
+{
+	for (int c = 0; c < NUM_SIGS; c++)
+	{
+		snprintf(writers->color, sizeof(writers->color), "%s", sigName[c]);
+		for (int w = 0; w < writers->count; w++)
+		{
+			writers->shape.x = (int) ((frame * 3 + w) % SHAPE_X_MAX);
+			writers->shape.y = (int) ((frame * 2 + c) % SHAPE_Y_MAX);
+			writers->writer[w]->write(writers->shape, DDS_HANDLE_NIL);
+		}
+	}
+}
+
+static bool wait_for_match(DDSDataReader **readers, int count, int publishers)
+{
+	DDS_SubscriptionMatchedStatus status;
+	int matched;
+
+	for (int waited = 0; waited < DEMUX_BENCH_MATCH_MS; waited += 10)
+	{
+		for (matched = 0; matched < count; matched++)
+		{
+			readers[matched]->get_subscription_matched_status(status);
+			if (status.current_count < publishers) break;
+		}
+		if (matched == count) return true;
+		usleep(10000);
+	}
+	return false;
+}
+
+// Same loaned batch take the demux does, once per filtered reader
+static uint64_t poll_filtered(ShapeTypeExtendedDataReader **readers, int count, ShapeTypeExtendedSeq &data, DDS_SampleInfoSeq &info)
+{
+	uint64_t delivered = 0;
+
+	for (int r = 0; r < count; r++)
+	{
+		if (readers[r]->take(data, info, DEMUX_TAKE_BATCH, DDS_ANY_SAMPLE_STATE, DDS_ANY_VIEW_STATE, DDS_ANY_INSTANCE_STATE)
+				!= DDS_RETCODE_OK)
+			continue;
+		for (int i = 0; i < info.length(); i++)
+			if (info[i].valid_data) delivered++;
+		readers[r]->return_loan(data, info);
+	}
+	return delivered;
+}
+
+static uint64_t poll_demux(struct ColorDemux *demux, int colors)
+{
+	struct DemuxSample sample;
+	uint64_t delivered = 0;
+
+	if (color_demux_poll(demux) <= 0) return 0;
+	for (int c = 0; c < colors; c++)
+		while (color_demux_pop(demux, c, &sample))
+			if (sample.valid) delivered++;
+	return delivered;
+}
+
+static int run_once(int domain_id, const struct TrackerConfig *config, struct BenchWriters *writers,
+		int colors, bool demux, struct DemuxRun *result)
+{
+	static struct ColorDemux color_demux;
+	DDSDomainParticipant *participant;
+	DDSTopic *topic;
+	DDSDataReader *reader[NUM_SIGS];
+	ShapeTypeExtendedDataReader *shape_reader[NUM_SIGS];
+	ShapeTypeExtendedSeq data;
+	DDS_SampleInfoSeq info;
+	const DDS_StringSeq noFilterParams;
+	char name[32];
+	char filter[50];
+	int readers = demux ? 1 : colors;
+	long resident_start;
+	int64_t start_us;
+	int64_t now_us;
+	int64_t cpu_start;
+	uint64_t frame = 0;
+	int status = -1;
+
+	memset(result, 0, sizeof(*result));
+	resident_start = resident_kb();
+	participant = transport_create_participant(domain_id, TRACKER_QOS_LIBRARY, config->qos_profile, config->transport);
+	if (participant == NULL)
+	{
+		fprintf(stderr, "demux bench: create reader participant error\n");
+		return -1;
+	}
+	topic = circle_topic(participant);
+	if (topic == NULL) goto done;
+
+	for (int r = 0; r < readers; r++)
+	{
+		DDSTopicDescription *description = topic;
+
+		if (!demux)
+		{
+			snprintf(name, sizeof(name), "DemuxBench%s", sigName[r]);
+			snprintf(filter, sizeof(filter), "color MATCH '%s'", sigName[r]);
+			description = participant->create_contentfilteredtopic(name, topic, filter, noFilterParams);
+			if (description == NULL) goto done;
+		}
+		reader[r] = transport_create_datareader(participant, description, TRACKER_QOS_LIBRARY, config->qos_profile,
+				config->transport, NULL, DDS_STATUS_MASK_NONE);
+		shape_reader[r] = ShapeTypeExtendedDataReader::narrow(reader[r]);
+		if (shape_reader[r] == NULL)
+		{
+			fprintf(stderr, "demux bench: create reader error\n");
+			goto done;
+		}
+	}
+	if (demux)
+		color_demux_init(&color_demux, shape_reader[0], (1u << colors) - 1);
+
+	if (!wait_for_match(reader, readers, writers->count))
+	{
+		fprintf(stderr, "demux bench: readers did not match %d publishers within %d ms\n", writers->count, DEMUX_BENCH_MATCH_MS);
+		goto done;
+	}
+
+	cpu_start = time_process_cpu_us();
+	start_us = time_monotonic_us();
+	while ((now_us = time_monotonic_us()) < start_us + DEMUX_BENCH_RUN_MS * 1000)
+	{
+		if (now_us >= start_us + (int64_t) (frame * 1000000 / DEMUX_BENCH_RATE_HZ))
+			writers_frame(writers, frame++);
+		result->delivered += demux ? poll_demux(&color_demux, colors) : poll_filtered(shape_reader, readers, data, info);
+	}
+	while (time_monotonic_us() < now_us + DEMUX_BENCH_DRAIN_MS * 1000)
+		result->delivered += demux ? poll_demux(&color_demux, colors) : poll_filtered(shape_reader, readers, data, info);
+	result->elapsed_us = time_monotonic_us() - start_us;
+	result->cpu_us = time_process_cpu_us() - cpu_start;
+	// After the run, so the readers' queues and the demux rings have
+	// grown to what this load needs
+	result->resident_kb = ((resident_start < 0) || (resident_kb() < 0)) ? -1 : resident_kb() - resident_start;
+	status = 0;
+
+done:
+	delete_participant(participant);
+	return status;
+}
+
+static int next_publishers(int publishers)
+{
+	return (publishers == 1) ? 4 : publishers * 4;
+}
+
+int demux_bench_run(int domain_id, const struct TrackerConfig *config, int max_publishers)
+{
+	struct BenchWriters writers;
+	struct DemuxRun result;
+	int status = 0;
+
+	printf("Demux bench on domain %d, %s over %s: every publisher writes all %d colors at %d Hz, %d ms per run\n"
+			"cpu%% is the whole process, publishers included; rss is what the subscribing side added by the end of the run\n",
+			domain_id, config->qos_profile, transport_name(config->transport), NUM_SIGS, DEMUX_BENCH_RATE_HZ,
+			DEMUX_BENCH_RUN_MS);
+	printf("%5s %6s %-6s %10s %7s %8s\n", "pubs", "colors", "reader", "samples/s", "cpu%", "rss KB");
+
+	for (int publishers = 1; publishers <= max_publishers; publishers = next_publishers(publishers))
+	{
+		if (writers_open(&writers, domain_id, config, publishers) != 0)
+		{
+			delete_participant(writers.participant);
+			return -1;
+		}
+		for (int colors = 1; colors <= NUM_SIGS; colors++)
+		{
+			for (int demux = 0; demux <= 1; demux++)
+			{
+				if (run_once(domain_id, config, &writers, colors, demux != 0, &result) != 0)
+				{
+					status = -1;
+					continue;
+				}
+				printf("%5d %6d %-6s %10.0f %7.1f %8ld\n", publishers, colors, demux ? "demux" : "cft",
+						(double) result.delivered * 1000000.0 / (double) result.elapsed_us,
+						100.0 * (double) result.cpu_us / (double) result.elapsed_us, result.resident_kb);
+			}
+		}
+		delete_participant(writers.participant);
+	}
+
+	return status;
+}
@@ -0,0 +1,27 @@
+//-------------------------------------------------------------------
+// demux_bench.h - N content-filtered readers vs one ColorDemux
+//
+// A bench participant runs P Circle writers, each publishing all
+// seven colors at a Pixy's frame rate.  For each color count N (1..7)
+// a fresh subscribing participant follows the first N colors, either
+// with one "color MATCH" reader per color (what N trackers would do)
+// or with one unfiltered reader and a ColorDemux.  Reported per run:
+// the samples delivered per second, process CPU (writers included;
+// they are the same in both modes) and the resident memory the
+// subscribing participant added by the end of the run, after the drain.
+//-------------------------------------------------------------------
+#ifndef DEMUX_BENCH_H
+#define DEMUX_BENCH_H
+
+#include "tracker.h"
+
+#define DEMUX_BENCH_RATE_HZ   30       // per color per publisher
+#define DEMUX_BENCH_RUN_MS    2000
+#define DEMUX_BENCH_MATCH_MS  10000
+#define DEMUX_BENCH_MAX_PUBLISHERS 256
+
+// Publisher counts go 1, 4, 16, ... up to max_publishers.  Uses the
+// config's QoS profile and transport.  Returns 0 if every run matched.
+int demux_bench_run(int domain_id, const struct TrackerConfig *config, int max_publishers);
+
+#endif
@@ -0,0 +1,564 @@
+
+
+/*
+WARNING: THIS FILE IS AUTO-GENERATED. DO NOT MODIFY.
+
+This file was generated from TrackerStatus.idl using "rtiddsgen".
+The rtiddsgen tool is part of the RTI Connext distribution.
+For more information, type 'rtiddsgen -help' at a command shell
+or consult the RTI Connext manual.
+*/
+
+#ifndef NDDS_STANDALONE_TYPE
+#ifndef ndds_cpp_h
+#include "ndds/ndds_cpp.h"
+#endif
+#ifndef dds_c_log_impl_h              
+#include "dds_c/dds_c_log_impl.h"                                
+#endif        
+
+#ifndef cdr_type_h
+#include "cdr/cdr_type.h"
+#endif    
+
+#ifndef osapi_heap_h
+#include "osapi/osapi_heap.h" 
+#endif
+#else
+#include "ndds_standalone_type.h"
+#endif
+
+#include "TrackerStatus.h"
+
+#include <new>
+
+/* ========================================================================= */
+const char *TrackerStatusTYPENAME = "TrackerStatus";
+
+DDS_TypeCode* TrackerStatus_get_typecode()
+{
+    static RTIBool is_initialized = RTI_FALSE;
+
+    static DDS_TypeCode TrackerStatus_g_tc_tracker_id_string = DDS_INITIALIZE_STRING_TYPECODE((64));
+    static DDS_TypeCode TrackerStatus_g_tc_color_string = DDS_INITIALIZE_STRING_TYPECODE((128));
+    static DDS_TypeCode_Member TrackerStatus_g_tc_members[12]=
+    {
+
+        {
+            (char *)"tracker_id",/* Member name */
+            {
+                0,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_KEY_MEMBER , /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"domain_id",/* Member name */
+            {
+                1,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"color",/* Member name */
+            {
+                2,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"pan",/* Member name */
+            {
+                3,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"tilt",/* Member name */
+            {
+                4,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"error_rms",/* Member name */
+            {
+                5,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"input_rate_hz",/* Member name */
+            {
+                6,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"output_rate_hz",/* Member name */
+            {
+                7,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"latency_p50_us",/* Member name */
+            {
+                8,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"latency_p90_us",/* Member name */
+            {
+                9,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"latency_p99_us",/* Member name */
+            {
+                10,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }, 
+        {
+            (char *)"latency_max_us",/* Member name */
+            {
+                11,/* Representation ID */          
+                DDS_BOOLEAN_FALSE,/* Is a pointer? */
+                -1, /* Bitfield bits */
+                NULL/* Member type code is assigned later */
+            },
+            0, /* Ignored */
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            RTI_CDR_REQUIRED_MEMBER, /* Is a key? */
+            DDS_PUBLIC_MEMBER,/* Member visibility */
+            1,
+            NULL/* Ignored */
+        }
+    };
+
+    static DDS_TypeCode TrackerStatus_g_tc =
+    {{
+            DDS_TK_STRUCT,/* Kind */
+            DDS_BOOLEAN_FALSE, /* Ignored */
+            -1, /*Ignored*/
+            (char *)"TrackerStatus", /* Name */
+            NULL, /* Ignored */      
+            0, /* Ignored */
+            0, /* Ignored */
+            NULL, /* Ignored */
+            12, /* Number of members */
+            TrackerStatus_g_tc_members, /* Members */
+            DDS_VM_NONE  /* Ignored */         
+        }}; /* Type code for TrackerStatus*/
+
+    if (is_initialized) {
+        return &TrackerStatus_g_tc;
+    }
+
+    TrackerStatus_g_tc_members[0]._representation._typeCode = (RTICdrTypeCode *)&TrackerStatus_g_tc_tracker_id_string;
+
+    TrackerStatus_g_tc_members[1]._representation._typeCode = (RTICdrTypeCode *)&DDS_g_tc_long;
+
+    TrackerStatus_g_tc_members[2]._representation._typeCode = (RTICdrTypeCode *)&TrackerStatus_g_tc_color_string;
+
+    TrackerStatus_g_tc_members[3]._representation._typeCode = (RTICdrTypeCode *)&DDS_g_tc_ushort;
+
+    TrackerStatus_g_tc_members[4]._representation._typeCode = (RTICdrTypeCode *)&DDS_g_tc_ushort;
+
+    TrackerStatus_g_tc_members[5]._representation._typeCode = (RTICdrTypeCode *)&DDS_g_tc_float;
+
+    TrackerStatus_g_tc_members[6]._representation._typeCode = (RTICdrTypeCode *)&DDS_g_tc_float;
+
+    TrackerStatus_g_tc_members[7]._representation._typeCode = (RTICdrTypeCode *)&DDS_g_tc_float;
+
+    TrackerStatus_g_tc_members[8]._representation._typeCode = (RTICdrTypeCode *)&DDS_g_tc_ulong;
+
+    TrackerStatus_g_tc_members[9]._representation._typeCode = (RTICdrTypeCode *)&DDS_g_tc_ulong;
+
+    TrackerStatus_g_tc_members[10]._representation._typeCode = (RTICdrTypeCode *)&DDS_g_tc_ulong;
+
+    TrackerStatus_g_tc_members[11]._representation._typeCode = (RTICdrTypeCode *)&DDS_g_tc_ulong;
+
+    is_initialized = RTI_TRUE;
+
+    return &TrackerStatus_g_tc;
+}
+
+RTIBool TrackerStatus_initialize(
+    TrackerStatus* sample) {
+    return TrackerStatus_initialize_ex(sample,RTI_TRUE,RTI_TRUE);
+}
+
+RTIBool TrackerStatus_initialize_ex(
+    TrackerStatus* sample,RTIBool allocatePointers, RTIBool allocateMemory)
+{
+
+    struct DDS_TypeAllocationParams_t allocParams =
+    DDS_TYPE_ALLOCATION_PARAMS_DEFAULT;
+
+    allocParams.allocate_pointers =  (DDS_Boolean)allocatePointers;
+    allocParams.allocate_memory = (DDS_Boolean)allocateMemory;
+
+    return TrackerStatus_initialize_w_params(
+        sample,&allocParams);
+
+}
+
+RTIBool TrackerStatus_initialize_w_params(
+    TrackerStatus* sample, const struct DDS_TypeAllocationParams_t * allocParams)
+{
+
+    if (sample == NULL) {
+        return RTI_FALSE;
+    }
+    if (allocParams == NULL) {
+        return RTI_FALSE;
+    }
+
+    if (allocParams->allocate_memory){
+        sample->tracker_id= DDS_String_alloc ((64));
+        if (sample->tracker_id == NULL) {
+            return RTI_FALSE;
+        }
+
+    } else {
+        if (sample->tracker_id!= NULL) { 
+            sample->tracker_id[0] = '\0';
+        }
+    }
+
+    if (!RTICdrType_initLong(&sample->domain_id)) {
+        return RTI_FALSE;
+    }
+
+    if (allocParams->allocate_memory){
+        sample->color= DDS_String_alloc ((128));
+        if (sample->color == NULL) {
+            return RTI_FALSE;
+        }
+
+    } else {
+        if (sample->color!= NULL) { 
+            sample->color[0] = '\0';
+        }
+    }
+
+    if (!RTICdrType_initUnsignedShort(&sample->pan)) {
+        return RTI_FALSE;
+    }
+
+    if (!RTICdrType_initUnsignedShort(&sample->tilt)) {
+        return RTI_FALSE;
+    }
+
+    if (!RTICdrType_initFloat(&sample->error_rms)) {
+        return RTI_FALSE;
+    }
+
+    if (!RTICdrType_initFloat(&sample->input_rate_hz)) {
+        return RTI_FALSE;
+    }
+
+    if (!RTICdrType_initFloat(&sample->output_rate_hz)) {
+        return RTI_FALSE;
+    }
+
+    if (!RTICdrType_initUnsignedLong(&sample->latency_p50_us)) {
+        return RTI_FALSE;
+    }
+
+    if (!RTICdrType_initUnsignedLong(&sample->latency_p90_us)) {
+        return RTI_FALSE;
+    }
+
+    if (!RTICdrType_initUnsignedLong(&sample->latency_p99_us)) {
+        return RTI_FALSE;
+    }
+
+    if (!RTICdrType_initUnsignedLong(&sample->latency_max_us)) {
+        return RTI_FALSE;
+    }
+
+    return RTI_TRUE;
+}
+
+void TrackerStatus_finalize(
+    TrackerStatus* sample)
+{
+
+    TrackerStatus_finalize_ex(sample,RTI_TRUE);
+}
+
+void TrackerStatus_finalize_ex(
+    TrackerStatus* sample,RTIBool deletePointers)
+{
+    struct DDS_TypeDeallocationParams_t deallocParams =
+    DDS_TYPE_DEALLOCATION_PARAMS_DEFAULT;
+
+    if (sample==NULL) {
+        return;
+    } 
+
+    deallocParams.delete_pointers = (DDS_Boolean)deletePointers;
+
+    TrackerStatus_finalize_w_params(
+        sample,&deallocParams);
+}
+
+void TrackerStatus_finalize_w_params(
+    TrackerStatus* sample,const struct DDS_TypeDeallocationParams_t * deallocParams)
+{
+
+    if (sample==NULL) {
+        return;
+    }
+
+    if (deallocParams == NULL) {
+        return;
+    }
+
+    if (sample->tracker_id != NULL) {
+        DDS_String_free(sample->tracker_id);
+        sample->tracker_id=NULL;
+
+    }
+
+    if (sample->color != NULL) {
+        DDS_String_free(sample->color);
+        sample->color=NULL;
+
+    }
+
+}
+
+void TrackerStatus_finalize_optional_members(
+    TrackerStatus* sample, RTIBool deletePointers)
+{
+    struct DDS_TypeDeallocationParams_t deallocParamsTmp =
+    DDS_TYPE_DEALLOCATION_PARAMS_DEFAULT;
+    struct DDS_TypeDeallocationParams_t * deallocParams =
+    &deallocParamsTmp;
+
+    if (sample==NULL) {
+        return;
+    } 
+    if (deallocParams) {} /* To avoid warnings */
+
+    deallocParamsTmp.delete_pointers = (DDS_Boolean)deletePointers;
+    deallocParamsTmp.delete_optional_members = DDS_BOOLEAN_TRUE;
+
+}
+
+RTIBool TrackerStatus_copy(
+    TrackerStatus* dst,
+    const TrackerStatus* src)
+{
+    try {
+
+        if (dst == NULL || src == NULL) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrType_copyStringEx (
+            &dst->tracker_id, src->tracker_id, 
+            (64) + 1, RTI_FALSE)){
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyLong (
+            &dst->domain_id, &src->domain_id)) { 
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyStringEx (
+            &dst->color, src->color, 
+            (128) + 1, RTI_FALSE)){
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyUnsignedShort (
+            &dst->pan, &src->pan)) { 
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyUnsignedShort (
+            &dst->tilt, &src->tilt)) { 
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyFloat (
+            &dst->error_rms, &src->error_rms)) { 
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyFloat (
+            &dst->input_rate_hz, &src->input_rate_hz)) { 
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyFloat (
+            &dst->output_rate_hz, &src->output_rate_hz)) { 
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyUnsignedLong (
+            &dst->latency_p50_us, &src->latency_p50_us)) { 
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyUnsignedLong (
+            &dst->latency_p90_us, &src->latency_p90_us)) { 
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyUnsignedLong (
+            &dst->latency_p99_us, &src->latency_p99_us)) { 
+            return RTI_FALSE;
+        }
+        if (!RTICdrType_copyUnsignedLong (
+            &dst->latency_max_us, &src->latency_max_us)) { 
+            return RTI_FALSE;
+        }
+
+        return RTI_TRUE;
+
+    } catch (std::bad_alloc&) {
+        return RTI_FALSE;
+    }
+}
+
+/**
+* <<IMPLEMENTATION>>
+*
+* Defines:  TSeq, T
+*
+* Configure and implement 'TrackerStatus' sequence class.
+*/
+#define T TrackerStatus
+#define TSeq TrackerStatusSeq
+
+#define T_initialize_w_params TrackerStatus_initialize_w_params
+
+#define T_finalize_w_params   TrackerStatus_finalize_w_params
+#define T_copy       TrackerStatus_copy
+
+#ifndef NDDS_STANDALONE_TYPE
+#include "dds_c/generic/dds_c_sequence_TSeq.gen"
+#include "dds_cpp/generic/dds_cpp_sequence_TSeq.gen"
+#else
+#include "dds_c_sequence_TSeq.gen"
+#include "dds_cpp_sequence_TSeq.gen"
+#endif
+
+#undef T_copy
+#undef T_finalize_w_params
+
+#undef T_initialize_w_params
+
+#undef TSeq
+#undef T
+
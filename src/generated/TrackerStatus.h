@@ -0,0 +1,116 @@
+
+
+/*
+WARNING: THIS FILE IS AUTO-GENERATED. DO NOT MODIFY.
+
+This file was generated from TrackerStatus.idl using "rtiddsgen".
+The rtiddsgen tool is part of the RTI Connext distribution.
+For more information, type 'rtiddsgen -help' at a command shell
+or consult the RTI Connext manual.
+*/
+
+#ifndef TrackerStatus_1390611725_h
+#define TrackerStatus_1390611725_h
+
+#ifndef NDDS_STANDALONE_TYPE
+#ifndef ndds_cpp_h
+#include "ndds/ndds_cpp.h"
+#endif
+#else
+#include "ndds_standalone_type.h"
+#endif
+
+static const DDS_Char * DEFAULT_TRACKER_STATUS_TOPIC_NAME= "pixy/tracker_status";
+
+extern "C" {
+
+    extern const char *TrackerStatusTYPENAME;
+
+}
+
+struct TrackerStatusSeq;
+#ifndef NDDS_STANDALONE_TYPE
+class TrackerStatusTypeSupport;
+class TrackerStatusDataWriter;
+class TrackerStatusDataReader;
+#endif
+
+class TrackerStatus 
+{
+  public:
+    typedef struct TrackerStatusSeq Seq;
+    #ifndef NDDS_STANDALONE_TYPE
+    typedef TrackerStatusTypeSupport TypeSupport;
+    typedef TrackerStatusDataWriter DataWriter;
+    typedef TrackerStatusDataReader DataReader;
+    #endif
+
+    DDS_Char *   tracker_id ;
+    DDS_Long   domain_id ;
+    DDS_Char *   color ;
+    DDS_UnsignedShort   pan ;
+    DDS_UnsignedShort   tilt ;
+    DDS_Float   error_rms ;
+    DDS_Float   input_rate_hz ;
+    DDS_Float   output_rate_hz ;
+    DDS_UnsignedLong   latency_p50_us ;
+    DDS_UnsignedLong   latency_p90_us ;
+    DDS_UnsignedLong   latency_p99_us ;
+    DDS_UnsignedLong   latency_max_us ;
+
+};
+#if (defined(RTI_WIN32) || defined (RTI_WINCE)) && defined(NDDS_USER_DLL_EXPORT)
+/* If the code is building on Windows, start exporting symbols.
+*/
+#undef NDDSUSERDllExport
+#define NDDSUSERDllExport __declspec(dllexport)
+#endif
+
+NDDSUSERDllExport DDS_TypeCode* TrackerStatus_get_typecode(void); /* Type code */
+
+DDS_SEQUENCE(TrackerStatusSeq, TrackerStatus);
+
+NDDSUSERDllExport
+RTIBool TrackerStatus_initialize(
+    TrackerStatus* self);
+
+NDDSUSERDllExport
+RTIBool TrackerStatus_initialize_ex(
+    TrackerStatus* self,RTIBool allocatePointers,RTIBool allocateMemory);
+
+NDDSUSERDllExport
+RTIBool TrackerStatus_initialize_w_params(
+    TrackerStatus* self,
+    const struct DDS_TypeAllocationParams_t * allocParams);  
+
+NDDSUSERDllExport
+void TrackerStatus_finalize(
+    TrackerStatus* self);
+
+NDDSUSERDllExport
+void TrackerStatus_finalize_ex(
+    TrackerStatus* self,RTIBool deletePointers);
+
+NDDSUSERDllExport
+void TrackerStatus_finalize_w_params(
+    TrackerStatus* self,
+    const struct DDS_TypeDeallocationParams_t * deallocParams);
+
+NDDSUSERDllExport
+void TrackerStatus_finalize_optional_members(
+    TrackerStatus* self, RTIBool deletePointers);  
+
+NDDSUSERDllExport
+RTIBool TrackerStatus_copy(
+    TrackerStatus* dst,
+    const TrackerStatus* src);
+
+#if (defined(RTI_WIN32) || defined (RTI_WINCE)) && defined(NDDS_USER_DLL_EXPORT)
+/* If the code is building on Windows, stop exporting symbols.
+*/
+#undef NDDSUSERDllExport
+#define NDDSUSERDllExport
+#endif
+
+#endif /* TrackerStatus */
+
@@ -0,0 +1,1669 @@
+
+/*
+WARNING: THIS FILE IS AUTO-GENERATED. DO NOT MODIFY.
+
+This file was generated from TrackerStatus.idl using "rtiddsgen".
+The rtiddsgen tool is part of the RTI Connext distribution.
+For more information, type 'rtiddsgen -help' at a command shell
+or consult the RTI Connext manual.
+*/
+
+#include <string.h>
+
+#ifndef ndds_cpp_h
+#include "ndds/ndds_cpp.h"
+#endif
+
+#ifndef osapi_type_h
+#include "osapi/osapi_type.h"
+#endif
+#ifndef osapi_heap_h
+#include "osapi/osapi_heap.h"
+#endif
+
+#ifndef osapi_utility_h
+#include "osapi/osapi_utility.h"
+#endif
+
+#ifndef cdr_type_h
+#include "cdr/cdr_type.h"
+#endif
+
+#ifndef cdr_type_object_h
+#include "cdr/cdr_typeObject.h"
+#endif
+
+#ifndef cdr_encapsulation_h
+#include "cdr/cdr_encapsulation.h"
+#endif
+
+#ifndef cdr_stream_h
+#include "cdr/cdr_stream.h"
+#endif
+
+#ifndef cdr_log_h
+#include "cdr/cdr_log.h"
+#endif
+
+#ifndef pres_typePlugin_h
+#include "pres/pres_typePlugin.h"
+#endif
+
+#define RTI_CDR_CURRENT_SUBMODULE RTI_CDR_SUBMODULE_MASK_STREAM
+
+#include <new>
+
+#include "TrackerStatusPlugin.h"
+
+/* ----------------------------------------------------------------------------
+*  Type TrackerStatus
+* -------------------------------------------------------------------------- */
+
+/* -----------------------------------------------------------------------------
+Support functions:
+* -------------------------------------------------------------------------- */
+
+TrackerStatus*
+TrackerStatusPluginSupport_create_data_w_params(
+    const struct DDS_TypeAllocationParams_t * alloc_params) 
+{
+    TrackerStatus *sample = NULL;
+
+    sample = new (std::nothrow) TrackerStatus ;
+    if (sample == NULL) {
+        return NULL;
+    }
+
+    if (!TrackerStatus_initialize_w_params(sample,alloc_params)) {
+        delete  sample;
+        sample=NULL;
+    }
+    return sample; 
+} 
+
+TrackerStatus *
+TrackerStatusPluginSupport_create_data_ex(RTIBool allocate_pointers) 
+{
+    TrackerStatus *sample = NULL;
+
+    sample = new (std::nothrow) TrackerStatus ;
+
+    if(sample == NULL) {
+        return NULL;
+    }
+
+    if (!TrackerStatus_initialize_ex(sample,allocate_pointers, RTI_TRUE)) {
+        delete  sample;
+        sample=NULL;
+    }
+
+    return sample; 
+}
+
+TrackerStatus *
+TrackerStatusPluginSupport_create_data(void)
+{
+    return TrackerStatusPluginSupport_create_data_ex(RTI_TRUE);
+}
+
+void 
+TrackerStatusPluginSupport_destroy_data_w_params(
+    TrackerStatus *sample,
+    const struct DDS_TypeDeallocationParams_t * dealloc_params) {
+
+    TrackerStatus_finalize_w_params(sample,dealloc_params);
+
+    delete  sample;
+    sample=NULL;
+}
+
+void 
+TrackerStatusPluginSupport_destroy_data_ex(
+    TrackerStatus *sample,RTIBool deallocate_pointers) {
+
+    TrackerStatus_finalize_ex(sample,deallocate_pointers);
+
+    delete  sample;
+    sample=NULL;
+}
+
+void 
+TrackerStatusPluginSupport_destroy_data(
+    TrackerStatus *sample) {
+
+    TrackerStatusPluginSupport_destroy_data_ex(sample,RTI_TRUE);
+
+}
+
+RTIBool 
+TrackerStatusPluginSupport_copy_data(
+    TrackerStatus *dst,
+    const TrackerStatus *src)
+{
+    return TrackerStatus_copy(dst,(const TrackerStatus*) src);
+}
+
+void 
+TrackerStatusPluginSupport_print_data(
+    const TrackerStatus *sample,
+    const char *desc,
+    unsigned int indent_level)
+{
+
+    RTICdrType_printIndent(indent_level);
+
+    if (desc != NULL) {
+        RTILog_debug("%s:\n", desc);
+    } else {
+        RTILog_debug("\n");
+    }
+
+    if (sample == NULL) {
+        RTILog_debug("NULL\n");
+        return;
+    }
+
+    if (sample->tracker_id==NULL) {
+        RTICdrType_printString(
+            NULL,"tracker_id", indent_level + 1);
+    } else {
+        RTICdrType_printString(
+            sample->tracker_id,"tracker_id", indent_level + 1);    
+    }
+
+    RTICdrType_printLong(
+        &sample->domain_id, "domain_id", indent_level + 1);    
+
+    if (sample->color==NULL) {
+        RTICdrType_printString(
+            NULL,"color", indent_level + 1);
+    } else {
+        RTICdrType_printString(
+            sample->color,"color", indent_level + 1);    
+    }
+
+    RTICdrType_printUnsignedShort(
+        &sample->pan, "pan", indent_level + 1);    
+
+    RTICdrType_printUnsignedShort(
+        &sample->tilt, "tilt", indent_level + 1);    
+
+    RTICdrType_printFloat(
+        &sample->error_rms, "error_rms", indent_level + 1);    
+
+    RTICdrType_printFloat(
+        &sample->input_rate_hz, "input_rate_hz", indent_level + 1);    
+
+    RTICdrType_printFloat(
+        &sample->output_rate_hz, "output_rate_hz", indent_level + 1);    
+
+    RTICdrType_printUnsignedLong(
+        &sample->latency_p50_us, "latency_p50_us", indent_level + 1);    
+
+    RTICdrType_printUnsignedLong(
+        &sample->latency_p90_us, "latency_p90_us", indent_level + 1);    
+
+    RTICdrType_printUnsignedLong(
+        &sample->latency_p99_us, "latency_p99_us", indent_level + 1);    
+
+    RTICdrType_printUnsignedLong(
+        &sample->latency_max_us, "latency_max_us", indent_level + 1);    
+
+}
+TrackerStatus *
+TrackerStatusPluginSupport_create_key_ex(RTIBool allocate_pointers){
+    TrackerStatus *key = NULL;
+
+    key = new (std::nothrow) TrackerStatusKeyHolder ;
+
+    TrackerStatus_initialize_ex(key,allocate_pointers, RTI_TRUE);
+
+    return key;
+}
+
+TrackerStatus *
+TrackerStatusPluginSupport_create_key(void)
+{
+    return  TrackerStatusPluginSupport_create_key_ex(RTI_TRUE);
+}
+
+void 
+TrackerStatusPluginSupport_destroy_key_ex(
+    TrackerStatusKeyHolder *key,RTIBool deallocate_pointers)
+{
+    TrackerStatus_finalize_ex(key,deallocate_pointers);
+
+    delete  key;
+    key=NULL;
+
+}
+
+void 
+TrackerStatusPluginSupport_destroy_key(
+    TrackerStatusKeyHolder *key) {
+
+    TrackerStatusPluginSupport_destroy_key_ex(key,RTI_TRUE);
+
+}
+
+/* ----------------------------------------------------------------------------
+Callback functions:
+* ---------------------------------------------------------------------------- */
+
+PRESTypePluginParticipantData 
+TrackerStatusPlugin_on_participant_attached(
+    void *registration_data,
+    const struct PRESTypePluginParticipantInfo *participant_info,
+    RTIBool top_level_registration,
+    void *container_plugin_context,
+    RTICdrTypeCode *type_code)
+{
+    if (registration_data) {} /* To avoid warnings */
+    if (participant_info) {} /* To avoid warnings */
+    if (top_level_registration) {} /* To avoid warnings */
+    if (container_plugin_context) {} /* To avoid warnings */
+    if (type_code) {} /* To avoid warnings */
+
+    return PRESTypePluginDefaultParticipantData_new(participant_info);
+
+}
+
+void 
+TrackerStatusPlugin_on_participant_detached(
+    PRESTypePluginParticipantData participant_data)
+{
+
+    PRESTypePluginDefaultParticipantData_delete(participant_data);
+}
+
+PRESTypePluginEndpointData
+TrackerStatusPlugin_on_endpoint_attached(
+    PRESTypePluginParticipantData participant_data,
+    const struct PRESTypePluginEndpointInfo *endpoint_info,
+    RTIBool top_level_registration, 
+    void *containerPluginContext)
+{
+    PRESTypePluginEndpointData epd = NULL;
+
+    unsigned int serializedSampleMaxSize;
+
+    unsigned int serializedKeyMaxSize;
+
+    if (top_level_registration) {} /* To avoid warnings */
+    if (containerPluginContext) {} /* To avoid warnings */
+
+    epd = PRESTypePluginDefaultEndpointData_new(
+        participant_data,
+        endpoint_info,
+        (PRESTypePluginDefaultEndpointDataCreateSampleFunction)
+        TrackerStatusPluginSupport_create_data,
+        (PRESTypePluginDefaultEndpointDataDestroySampleFunction)
+        TrackerStatusPluginSupport_destroy_data,
+        (PRESTypePluginDefaultEndpointDataCreateKeyFunction)
+        TrackerStatusPluginSupport_create_key ,            
+        (PRESTypePluginDefaultEndpointDataDestroyKeyFunction)
+        TrackerStatusPluginSupport_destroy_key);
+
+    if (epd == NULL) {
+        return NULL;
+    } 
+    serializedKeyMaxSize =  TrackerStatusPlugin_get_serialized_key_max_size(
+        epd,RTI_FALSE,RTI_CDR_ENCAPSULATION_ID_CDR_BE,0);
+
+    if(!PRESTypePluginDefaultEndpointData_createMD5StreamWithInfo(
+        epd,endpoint_info,serializedKeyMaxSize))  
+    {
+        PRESTypePluginDefaultEndpointData_delete(epd);
+        return NULL;
+    }
+
+    if (endpoint_info->endpointKind == PRES_TYPEPLUGIN_ENDPOINT_WRITER) {
+        serializedSampleMaxSize = TrackerStatusPlugin_get_serialized_sample_max_size(
+            epd,RTI_FALSE,RTI_CDR_ENCAPSULATION_ID_CDR_BE,0);
+
+        PRESTypePluginDefaultEndpointData_setMaxSizeSerializedSample(epd, serializedSampleMaxSize);
+
+        if (PRESTypePluginDefaultEndpointData_createWriterPool(
+            epd,
+            endpoint_info,
+            (PRESTypePluginGetSerializedSampleMaxSizeFunction)
+            TrackerStatusPlugin_get_serialized_sample_max_size, epd,
+            (PRESTypePluginGetSerializedSampleSizeFunction)
+            TrackerStatusPlugin_get_serialized_sample_size,
+            epd) == RTI_FALSE) {
+            PRESTypePluginDefaultEndpointData_delete(epd);
+            return NULL;
+        }
+    }
+
+    return epd;    
+}
+
+void 
+TrackerStatusPlugin_on_endpoint_detached(
+    PRESTypePluginEndpointData endpoint_data)
+{  
+
+    PRESTypePluginDefaultEndpointData_delete(endpoint_data);
+}
+
+void    
+TrackerStatusPlugin_return_sample(
+    PRESTypePluginEndpointData endpoint_data,
+    TrackerStatus *sample,
+    void *handle)
+{
+
+    TrackerStatus_finalize_optional_members(sample, RTI_TRUE);
+
+    PRESTypePluginDefaultEndpointData_returnSample(
+        endpoint_data, sample, handle);
+}
+
+RTIBool 
+TrackerStatusPlugin_copy_sample(
+    PRESTypePluginEndpointData endpoint_data,
+    TrackerStatus *dst,
+    const TrackerStatus *src)
+{
+    if (endpoint_data) {} /* To avoid warnings */
+    return TrackerStatusPluginSupport_copy_data(dst,src);
+}
+
+/* ----------------------------------------------------------------------------
+(De)Serialize functions:
+* ------------------------------------------------------------------------- */
+unsigned int 
+TrackerStatusPlugin_get_serialized_sample_max_size(
+    PRESTypePluginEndpointData endpoint_data,
+    RTIBool include_encapsulation,
+    RTIEncapsulationId encapsulation_id,
+    unsigned int current_alignment);
+
+RTIBool 
+TrackerStatusPlugin_serialize(
+    PRESTypePluginEndpointData endpoint_data,
+    const TrackerStatus *sample, 
+    struct RTICdrStream *stream,    
+    RTIBool serialize_encapsulation,
+    RTIEncapsulationId encapsulation_id,
+    RTIBool serialize_sample, 
+    void *endpoint_plugin_qos)
+{
+    char * position = NULL;
+    RTIBool retval = RTI_TRUE;
+
+    if (endpoint_data) {} /* To avoid warnings */
+    if (endpoint_plugin_qos) {} /* To avoid warnings */
+
+    if(serialize_encapsulation) {
+        if (!RTICdrStream_serializeAndSetCdrEncapsulation(stream , encapsulation_id)) {
+            return RTI_FALSE;
+        }
+
+        position = RTICdrStream_resetAlignment(stream);
+    }
+
+    if(serialize_sample) {
+
+        if (!RTICdrStream_serializeString(
+            stream, sample->tracker_id, (64) + 1)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeLong(
+            stream, &sample->domain_id)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeString(
+            stream, sample->color, (128) + 1)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeUnsignedShort(
+            stream, &sample->pan)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeUnsignedShort(
+            stream, &sample->tilt)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeFloat(
+            stream, &sample->error_rms)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeFloat(
+            stream, &sample->input_rate_hz)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeFloat(
+            stream, &sample->output_rate_hz)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeUnsignedLong(
+            stream, &sample->latency_p50_us)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeUnsignedLong(
+            stream, &sample->latency_p90_us)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeUnsignedLong(
+            stream, &sample->latency_p99_us)) {
+            return RTI_FALSE;
+        }
+
+        if (!RTICdrStream_serializeUnsignedLong(
+            stream, &sample->latency_max_us)) {
+            return RTI_FALSE;
+        }
+
+    }
+
+    if(serialize_encapsulation) {
+        RTICdrStream_restoreAlignment(stream,position);
+    }
+
+    return retval;
+}
+
+RTIBool 
+TrackerStatusPlugin_deserialize_sample(
+    PRESTypePluginEndpointData endpoint_data,
+    TrackerStatus *sample,
+    struct RTICdrStream *stream,   
+    RTIBool deserialize_encapsulation,
+    RTIBool deserialize_sample, 
+    void *endpoint_plugin_qos)
+{
+
+    char * position = NULL;
+
+    RTIBool done = RTI_FALSE;
+
+    try {
+
+        if (endpoint_data) {} /* To avoid warnings */
+        if (endpoint_plugin_qos) {} /* To avoid warnings */
+        if(deserialize_encapsulation) {
+
+            if (!RTICdrStream_deserializeAndSetCdrEncapsulation(stream)) {
+                return RTI_FALSE;
+            }
+
+            position = RTICdrStream_resetAlignment(stream);
+        }
+        if(deserialize_sample) {
+
+            TrackerStatus_initialize_ex(sample, RTI_FALSE, RTI_FALSE);
+
+            if (!RTICdrStream_deserializeStringEx(
+                stream,&sample->tracker_id, (64) + 1, RTI_FALSE)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeLong(
+                stream, &sample->domain_id)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeStringEx(
+                stream,&sample->color, (128) + 1, RTI_FALSE)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeUnsignedShort(
+                stream, &sample->pan)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeUnsignedShort(
+                stream, &sample->tilt)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeFloat(
+                stream, &sample->error_rms)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeFloat(
+                stream, &sample->input_rate_hz)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeFloat(
+                stream, &sample->output_rate_hz)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeUnsignedLong(
+                stream, &sample->latency_p50_us)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeUnsignedLong(
+                stream, &sample->latency_p90_us)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeUnsignedLong(
+                stream, &sample->latency_p99_us)) {
+                goto fin; 
+            }
+            if (!RTICdrStream_deserializeUnsignedLong(
+                stream, &sample->latency_max_us)) {
+                goto fin; 
+            }
+        }
+
+        done = RTI_TRUE;
+      fin:
+        if (done != RTI_TRUE && 
+        RTICdrStream_getRemainder(stream) >=
+        RTI_CDR_PARAMETER_HEADER_ALIGNMENT) {
+            return RTI_FALSE;   
+        }
+        if(deserialize_encapsulation) {
+            RTICdrStream_restoreAlignment(stream,position);
+        }
+
+        return RTI_TRUE;
+
+    } catch (std::bad_alloc&) {
+        return RTI_FALSE;
+    }
+}
+
+RTIBool
+TrackerStatusPlugin_serialize_to_cdr_buffer(
+    char * buffer,
+    unsigned int * length,
+    const TrackerStatus *sample)
+{
+    struct RTICdrStream stream;
+    struct PRESTypePluginDefaultEndpointData epd;
+    RTIBool result;
+
+    if (length == NULL) {
+        return RTI_FALSE;
+    }
+
+    epd._maxSizeSerializedSample =
+    TrackerStatusPlugin_get_serialized_sample_max_size(
+        NULL, RTI_TRUE, RTICdrEncapsulation_getNativeCdrEncapsulationId(), 0);
+
+    if (buffer == NULL) {
+        *length = 
+        TrackerStatusPlugin_get_serialized_sample_size(
+            (PRESTypePluginEndpointData)&epd,
+            RTI_TRUE,
+            RTICdrEncapsulation_getNativeCdrEncapsulationId(),
+            0,
+            sample);
+
+        if (*length == 0) {
+            return RTI_FALSE;
+        }
+
+        return RTI_TRUE;
+    }    
+
+    RTICdrStream_init(&stream);
+    RTICdrStream_set(&stream, (char *)buffer, *length);
+
+    result = TrackerStatusPlugin_serialize(
+        (PRESTypePluginEndpointData)&epd, sample, &stream, 
+        RTI_TRUE, RTICdrEncapsulation_getNativeCdrEncapsulationId(), 
+        RTI_TRUE, NULL);  
+
+    *length = RTICdrStream_getCurrentPositionOffset(&stream);
+    return result;     
+}
+
+RTIBool
+TrackerStatusPlugin_deserialize_from_cdr_buffer(
+    TrackerStatus *sample,
+    const char * buffer,
+    unsigned int length)
+{
+    struct RTICdrStream stream;
+
+    RTICdrStream_init(&stream);
+    RTICdrStream_set(&stream, (char *)buffer, length);
+
+    TrackerStatus_finalize_optional_members(sample, RTI_TRUE);
+    return TrackerStatusPlugin_deserialize_sample( 
+        NULL, sample,
+        &stream, RTI_TRUE, RTI_TRUE, 
+        NULL);
+}
+
+DDS_ReturnCode_t
+TrackerStatusPlugin_data_to_string(
+    const TrackerStatus *sample,
+    char *str,
+    DDS_UnsignedLong *str_size, 
+    const struct DDS_PrintFormatProperty *property)
+{
+    DDS_DynamicData *data = NULL;
+    char *buffer = NULL;
+    unsigned int length = 0;
+    struct DDS_PrintFormat printFormat;
+    DDS_ReturnCode_t retCode = DDS_RETCODE_ERROR;
+
+    if (sample == NULL) {
+        return DDS_RETCODE_BAD_PARAMETER;
+    }
+
+    if (str_size == NULL) {
+        return DDS_RETCODE_BAD_PARAMETER;
+    }
+
+    if (property == NULL) {
+        return DDS_RETCODE_BAD_PARAMETER;
+    }
+
+    if (!TrackerStatusPlugin_serialize_to_cdr_buffer(
+        NULL, 
+        &length, 
+        sample)) {
+        return DDS_RETCODE_ERROR;
+    }
+
+    RTIOsapiHeap_allocateBuffer(&buffer, length, RTI_OSAPI_ALIGNMENT_DEFAULT);
+    if (buffer == NULL) {
+        return DDS_RETCODE_ERROR;
+    }
+
+    if (!TrackerStatusPlugin_serialize_to_cdr_buffer(
+        buffer, 
+        &length, 
+        sample)) {
+        RTIOsapiHeap_freeBuffer(buffer);
+        return DDS_RETCODE_ERROR;
+    }
+
+    data = DDS_DynamicData_new(
+        TrackerStatus_get_typecode(), 
+        &DDS_DYNAMIC_DATA_PROPERTY_DEFAULT);
+    if (data == NULL) {
+        RTIOsapiHeap_freeBuffer(buffer);
+        return DDS_RETCODE_ERROR;
+    }
+
+    retCode = DDS_DynamicData_from_cdr_buffer(data, buffer, length);
+    if (retCode != DDS_RETCODE_OK) {
+        RTIOsapiHeap_freeBuffer(buffer);
+        DDS_DynamicData_delete(data);
+        return retCode;
+    }
+
+    retCode = DDS_PrintFormatProperty_to_print_format(
+        property, 
+        &printFormat);
+    if (retCode != DDS_RETCODE_OK) {
+        RTIOsapiHeap_freeBuffer(buffer);
+        DDS_DynamicData_delete(data);
+        return retCode;
+    }
+
+    retCode = DDS_DynamicDataFormatter_to_string_w_format(
+        data, 
+        str,
+        str_size, 
+        &printFormat);
+    if (retCode != DDS_RETCODE_OK) {
+        RTIOsapiHeap_freeBuffer(buffer);
+        DDS_DynamicData_delete(data);
+        return retCode;
+    }
+
+    RTIOsapiHeap_freeBuffer(buffer);
+    DDS_DynamicData_delete(data);
+    return DDS_RETCODE_OK;
+}
+
+RTIBool 
+TrackerStatusPlugin_deserialize(
+    PRESTypePluginEndpointData endpoint_data,
+    TrackerStatus **sample,
+    RTIBool * drop_sample,
+    struct RTICdrStream *stream,   
+    RTIBool deserialize_encapsulation,
+    RTIBool deserialize_sample, 
+    void *endpoint_plugin_qos)
+{
+
+    RTIBool result;
+    const char *METHOD_NAME = "TrackerStatusPlugin_deserialize";
+    if (drop_sample) {} /* To avoid warnings */
+
+    stream->_xTypesState.unassignable = RTI_FALSE;
+    result= TrackerStatusPlugin_deserialize_sample( 
+        endpoint_data, (sample != NULL)?*sample:NULL,
+        stream, deserialize_encapsulation, deserialize_sample, 
+        endpoint_plugin_qos);
+    if (result) {
+        if (stream->_xTypesState.unassignable) {
+            result = RTI_FALSE;
+        }
+    }
+    if (!result && stream->_xTypesState.unassignable ) {
+
+        RTICdrLog_exception(
+            METHOD_NAME, 
+            &RTI_CDR_LOG_UNASSIGNABLE_SAMPLE_OF_TYPE_s, 
+            "TrackerStatus");
+
+    }
+
+    return result;
+
+}
+
+RTIBool TrackerStatusPlugin_skip(
+    PRESTypePluginEndpointData endpoint_data,
+    struct RTICdrStream *stream,   
+    RTIBool skip_encapsulation,
+    RTIBool skip_sample, 
+    void *endpoint_plugin_qos)
+{
+    char * position = NULL;
+
+    RTIBool done = RTI_FALSE;
+
+    if (endpoint_data) {} /* To avoid warnings */
+    if (endpoint_plugin_qos) {} /* To avoid warnings */
+
+    if(skip_encapsulation) {
+        if (!RTICdrStream_skipEncapsulation(stream)) {
+            return RTI_FALSE;
+        }
+
+        position = RTICdrStream_resetAlignment(stream);
+    }
+
+    if (skip_sample) {
+
+        if (!RTICdrStream_skipString (stream, (64)+1)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipLong (stream)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipString (stream, (128)+1)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipUnsignedShort (stream)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipUnsignedShort (stream)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipFloat (stream)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipFloat (stream)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipFloat (stream)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipUnsignedLong (stream)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipUnsignedLong (stream)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipUnsignedLong (stream)) {
+            goto fin; 
+        }
+        if (!RTICdrStream_skipUnsignedLong (stream)) {
+            goto fin; 
+        }
+    }
+
+    done = RTI_TRUE;
+  fin:
+    if (done != RTI_TRUE && 
+    RTICdrStream_getRemainder(stream) >=
+    RTI_CDR_PARAMETER_HEADER_ALIGNMENT) {
+        return RTI_FALSE;   
+    }
+    if(skip_encapsulation) {
+        RTICdrStream_restoreAlignment(stream,position);
+    }
+
+    return RTI_TRUE;
+}
+
+unsigned int 
+TrackerStatusPlugin_get_serialized_sample_max_size_ex(
+    PRESTypePluginEndpointData endpoint_data,
+    RTIBool * overflow,
+    RTIBool include_encapsulation,
+    RTIEncapsulationId encapsulation_id,
+    unsigned int current_alignment)
+{
+
+    unsigned int initial_alignment = current_alignment;
+
+    unsigned int encapsulation_size = current_alignment;
+
+    if (endpoint_data) {} /* To avoid warnings */ 
+    if (overflow) {} /* To avoid warnings */
+
+    if (include_encapsulation) {
+
+        if (!RTICdrEncapsulation_validEncapsulationId(encapsulation_id)) {
+            return 1;
+        }
+        RTICdrStream_getEncapsulationSize(encapsulation_size);
+        encapsulation_size -= current_alignment;
+        current_alignment = 0;
+        initial_alignment = 0;
+    }
+
+    current_alignment +=RTICdrType_getStringMaxSizeSerialized(
+        current_alignment, (64)+1);
+
+    current_alignment +=RTICdrType_getLongMaxSizeSerialized(
+        current_alignment);
+
+    current_alignment +=RTICdrType_getStringMaxSizeSerialized(
+        current_alignment, (128)+1);
+
+    current_alignment +=RTICdrType_getUnsignedShortMaxSizeSerialized(
+        current_alignment);
+
+    current_alignment +=RTICdrType_getUnsignedShortMaxSizeSerialized(
+        current_alignment);
+
+    current_alignment +=RTICdrType_getFloatMaxSizeSerialized(
+        current_alignment);
+
+    current_alignment +=RTICdrType_getFloatMaxSizeSerialized(
+        current_alignment);
+
+    current_alignment +=RTICdrType_getFloatMaxSizeSerialized(
+        current_alignment);
+
+    current_alignment +=RTICdrType_getUnsignedLongMaxSizeSerialized(
+        current_alignment);
+
+    current_alignment +=RTICdrType_getUnsignedLongMaxSizeSerialized(
+        current_alignment);
+
+    current_alignment +=RTICdrType_getUnsignedLongMaxSizeSerialized(
+        current_alignment);
+
+    current_alignment +=RTICdrType_getUnsignedLongMaxSizeSerialized(
+        current_alignment);
+
+    if (include_encapsulation) {
+        current_alignment += encapsulation_size;
+    }
+    return  current_alignment - initial_alignment;
+}
+
+unsigned int 
+TrackerStatusPlugin_get_serialized_sample_max_size(
+    PRESTypePluginEndpointData endpoint_data,
+    RTIBool include_encapsulation,
+    RTIEncapsulationId encapsulation_id,
+    unsigned int current_alignment)
+{
+    unsigned int size;
+    RTIBool overflow = RTI_FALSE;
+
+    size = TrackerStatusPlugin_get_serialized_sample_max_size_ex(
+        endpoint_data,&overflow,include_encapsulation,encapsulation_id,current_alignment);
+
+    if (overflow) {
+        size = RTI_CDR_MAX_SERIALIZED_SIZE;
+    }
+
+    return size;
+}
+
+unsigned int 
+TrackerStatusPlugin_get_serialized_sample_min_size(
+    PRESTypePluginEndpointData endpoint_data,
+    RTIBool include_encapsulation,
+    RTIEncapsulationId encapsulation_id,
+    unsigned int current_alignment)
+{
+
+    unsigned int initial_alignment = current_alignment;
+
+    unsigned int encapsulation_size = current_alignment;
+
+    if (endpoint_data) {} /* To avoid warnings */ 
+
+    if (include_encapsulation) {
+
+        if (!RTICdrEncapsulation_validEncapsulationId(encapsulation_id)) {
+            return 1;
+        }
+        RTICdrStream_getEncapsulationSize(encapsulation_size);
+        encapsulation_size -= current_alignment;
+        current_alignment = 0;
+        initial_alignment = 0;
+    }
+
+    current_alignment +=RTICdrType_getStringMaxSizeSerialized(
+        current_alignment, 1);
+    current_alignment +=RTICdrType_getLongMaxSizeSerialized(
+        current_alignment);
+    current_alignment +=RTICdrType_getStringMaxSizeSerialized(
+        current_alignment, 1);
+    current_alignment +=RTICdrType_getUnsignedShortMaxSizeSerialized(
+        current_alignment);
+    current_alignment +=RTICdrType_getUnsignedShortMaxSizeSerialized(
+        current_alignment);
+    current_alignment +=RTICdrType_getFloatMaxSizeSerialized(
+        current_alignment);
+    current_alignment +=RTICdrType_getFloatMaxSizeSerialized(
+        current_alignment);
+    current_alignment +=RTICdrType_getFloatMaxSizeSerialized(
+        current_alignment);
+    current_alignment +=RTICdrType_getUnsignedLongMaxSizeSerialized(
+        current_alignment);
+    current_alignment +=RTICdrType_getUnsignedLongMaxSizeSerialized(
+        current_alignment);
+    current_alignment +=RTICdrType_getUnsignedLongMaxSizeSerialized(
+        current_alignment);
+    current_alignment +=RTICdrType_getUnsignedLongMaxSizeSerialized(
+        current_alignment);
+
+    if (include_encapsulation) {
+        current_alignment += encapsulation_size;
+    }
+    return  current_alignment - initial_alignment;
+}
+
+/* Returns the size of the sample in its serialized form (in bytes).
+* It can also be an estimation in excess of the real buffer needed 
+* during a call to the serialize() function.
+* The value reported does not have to include the space for the
+* encapsulation flags.
+*/
+unsigned int
+TrackerStatusPlugin_get_serialized_sample_size(
+    PRESTypePluginEndpointData endpoint_data,
+    RTIBool include_encapsulation,
+    RTIEncapsulationId encapsulation_id,
+    unsigned int current_alignment,
+    const TrackerStatus * sample) 
+{
+
+    unsigned int initial_alignment = current_alignment;
+
+    unsigned int encapsulation_size = current_alignment;
+    struct PRESTypePluginDefaultEndpointData epd;   
+
+    if (sample==NULL) {
+        return 0;
+    }
+    if (endpoint_data == NULL) {
+        endpoint_data = (PRESTypePluginEndpointData) &epd;
+        PRESTypePluginDefaultEndpointData_setBaseAlignment(
+            endpoint_data,
+            current_alignment);        
+    }
+
+    if (include_encapsulation) {
+
+        if (!RTICdrEncapsulation_validEncapsulationId(encapsulation_id)) {
+            return 1;
+        }
+        RTICdrStream_getEncapsulationSize(encapsulation_size);
+        encapsulation_size -= current_alignment;
+        current_alignment = 0;
+        initial_alignment = 0;
+        PRESTypePluginDefaultEndpointData_setBaseAlignment(
+            endpoint_data,
+            current_alignment);
+    }
+
+    current_alignment += RTICdrType_getStringSerializedSize(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment), sample->tracker_id);
+
+    current_alignment += RTICdrType_getLongMaxSizeSerialized(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment));
+
+    current_alignment += RTICdrType_getStringSerializedSize(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment), sample->color);
+
+    current_alignment += RTICdrType_getUnsignedShortMaxSizeSerialized(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment));
+
+    current_alignment += RTICdrType_getUnsignedShortMaxSizeSerialized(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment));
+
+    current_alignment += RTICdrType_getFloatMaxSizeSerialized(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment));
+
+    current_alignment += RTICdrType_getFloatMaxSizeSerialized(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment));
+
+    current_alignment += RTICdrType_getFloatMaxSizeSerialized(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment));
+
+    current_alignment += RTICdrType_getUnsignedLongMaxSizeSerialized(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment));
+
+    current_alignment += RTICdrType_getUnsignedLongMaxSizeSerialized(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment));
+
+    current_alignment += RTICdrType_getUnsignedLongMaxSizeSerialized(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment));
+
+    current_alignment += RTICdrType_getUnsignedLongMaxSizeSerialized(
+        PRESTypePluginDefaultEndpointData_getAlignment(
+            endpoint_data, current_alignment));
+
+    if (include_encapsulation) {
+        current_alignment += encapsulation_size;
+    }
+    return current_alignment - initial_alignment;
+}
+
+/* --------------------------------------------------------------------------------------
+Key Management functions:
+* -------------------------------------------------------------------------------------- */
+
+PRESTypePluginKeyKind 
+TrackerStatusPlugin_get_key_kind(void)
+{
+    return PRES_TYPEPLUGIN_USER_KEY;
+}
+
+RTIBool 
+TrackerStatusPlugin_serialize_key(
+    PRESTypePluginEndpointData endpoint_data,
+    const TrackerStatus *sample, 
+    struct RTICdrStream *stream,    
+    RTIBool serialize_encapsulation,
+    RTIEncapsulationId encapsulation_id,
+    RTIBool serialize_key,
+    void *endpoint_plugin_qos)
+{
+    char * position = NULL;
+
+    if (endpoint_data) {} /* To avoid warnings */
+    if (endpoint_plugin_qos) {} /* To avoid warnings */
+
+    if(serialize_encapsulation) {
+        if (!RTICdrStream_serializeAndSetCdrEncapsulation(stream , encapsulation_id)) {
+            return RTI_FALSE;
+        }
+
+        position = RTICdrStream_resetAlignment(stream);
+    }
+
+    if(serialize_key) {
+
+        if (!RTICdrStream_serializeString(
+            stream, sample->tracker_id, (64) + 1)) {
+            return RTI_FALSE;
+        }
+
+    }
+
+    if(serialize_encapsulation) {
+        RTICdrStream_restoreAlignment(stream,position);
+    }
+
+    return RTI_TRUE;
+}
+
+RTIBool TrackerStatusPlugin_deserialize_key_sample(
+    PRESTypePluginEndpointData endpoint_data,
+    TrackerStatus *sample, 
+    struct RTICdrStream *stream,
+    RTIBool deserialize_encapsulation,
+    RTIBool deserialize_key,
+    void *endpoint_plugin_qos)
+{
+    try {
+
+        char * position = NULL;
+
+        if (endpoint_data) {} /* To avoid warnings */
+        if (endpoint_plugin_qos) {} /* To avoid warnings */
+
+        if(deserialize_encapsulation) {
+
+            if (!RTICdrStream_deserializeAndSetCdrEncapsulation(stream)) {
+                return RTI_FALSE;
+            }
+
+            position = RTICdrStream_resetAlignment(stream);
+        }
+        if (deserialize_key) {
+
+            if (!RTICdrStream_deserializeStringEx(
+                stream,&sample->tracker_id, (64) + 1, RTI_FALSE)) {
+                return RTI_FALSE;
+            }
+        }
+
+        if(deserialize_encapsulation) {
+            RTICdrStream_restoreAlignment(stream,position);
+        }
+
+        return RTI_TRUE;
+
+    } catch (std::bad_alloc&) {
+        return RTI_FALSE;
+    }
+}
+
+RTIBool TrackerStatusPlugin_deserialize_key(
+    PRESTypePluginEndpointData endpoint_data,
+    TrackerStatus **sample, 
+    RTIBool * drop_sample,
+    struct RTICdrStream *stream,
+    RTIBool deserialize_encapsulation,
+    RTIBool deserialize_key,
+    void *endpoint_plugin_qos)
+{
+    RTIBool result;
+    if (drop_sample) {} /* To avoid warnings */
+    stream->_xTypesState.unassignable = RTI_FALSE;
+    result= TrackerStatusPlugin_deserialize_key_sample(
+        endpoint_data, (sample != NULL)?*sample:NULL, stream,
+        deserialize_encapsulation, deserialize_key, endpoint_plugin_qos);
+    if (result) {
+        if (stream->_xTypesState.unassignable) {
+            result = RTI_FALSE;
+        }
+    }
+
+    return result;    
+
+}
+
+unsigned int
+TrackerStatusPlugin_get_serialized_key_max_size_ex(
+    PRESTypePluginEndpointData endpoint_data,
+    RTIBool * overflow,
+    RTIBool include_encapsulation,
+    RTIEncapsulationId encapsulation_id,
+    unsigned int current_alignment)
+{
+
+    unsigned int initial_alignment = current_alignment;
+
+    unsigned int encapsulation_size = current_alignment;
+
+    if (endpoint_data) {} /* To avoid warnings */
+    if (overflow) {} /* To avoid warnings */
+
+    if (include_encapsulation) {
+
+        if (!RTICdrEncapsulation_validEncapsulationId(encapsulation_id)) {
+            return 1;
+        }
+        RTICdrStream_getEncapsulationSize(encapsulation_size);
+        encapsulation_size -= current_alignment;
+        current_alignment = 0;
+        initial_alignment = 0;
+    }
+
+    current_alignment +=RTICdrType_getStringMaxSizeSerialized(
+        current_alignment, (64)+1);
+
+    if (include_encapsulation) {
+        current_alignment += encapsulation_size;
+    }
+    return current_alignment - initial_alignment;
+}
+
+unsigned int
+TrackerStatusPlugin_get_serialized_key_max_size(
+    PRESTypePluginEndpointData endpoint_data,
+    RTIBool include_encapsulation,
+    RTIEncapsulationId encapsulation_id,
+    unsigned int current_alignment)
+{
+    unsigned int size;
+    RTIBool overflow = RTI_FALSE;
+
+    size = TrackerStatusPlugin_get_serialized_key_max_size_ex(
+        endpoint_data,&overflow,include_encapsulation,encapsulation_id,current_alignment);
+
+    if (overflow) {
+        size = RTI_CDR_MAX_SERIALIZED_SIZE;
+    }
+
+    return size;
+}
+
+RTIBool 
+TrackerStatusPlugin_serialized_sample_to_key(
+    PRESTypePluginEndpointData endpoint_data,
+    TrackerStatus *sample,
+    struct RTICdrStream *stream, 
+    RTIBool deserialize_encapsulation,  
+    RTIBool deserialize_key, 
+    void *endpoint_plugin_qos)
+{
+    char * position = NULL;
+
+    RTIBool done = RTI_FALSE;
+    RTIBool error = RTI_FALSE;
+
+    if (endpoint_data) {} /* To avoid warnings */
+    if (endpoint_plugin_qos) {} /* To avoid warnings */
+
+    if (stream == NULL) {
+        error = RTI_TRUE;
+        goto fin;
+    }
+    if(deserialize_encapsulation) {
+        if (!RTICdrStream_deserializeAndSetCdrEncapsulation(stream)) {
+            return RTI_FALSE;
+        }
+        position = RTICdrStream_resetAlignment(stream);
+    }
+
+    if (deserialize_key) {
+
+        if (!RTICdrStream_deserializeStringEx(
+            stream,&sample->tracker_id, (64) + 1, RTI_FALSE)) {
+            return RTI_FALSE;
+        }
+        if (!RTICdrStream_skipLong (stream)) {
+            goto fin; 
+        }
+
+        if (!RTICdrStream_skipString (stream, (128)+1)) {
+            goto fin; 
+        }
+
+        if (!RTICdrStream_skipUnsignedShort (stream)) {
+            goto fin; 
+        }
+
+        if (!RTICdrStream_skipUnsignedShort (stream)) {
+            goto fin; 
+        }
+
+        if (!RTICdrStream_skipFloat (stream)) {
+            goto fin; 
+        }
+
+        if (!RTICdrStream_skipFloat (stream)) {
+            goto fin; 
+        }
+
+        if (!RTICdrStream_skipFloat (stream)) {
+            goto fin; 
+        }
+
+        if (!RTICdrStream_skipUnsignedLong (stream)) {
+            goto fin; 
+        }
+
+        if (!RTICdrStream_skipUnsignedLong (stream)) {
+            goto fin; 
+        }
+
+        if (!RTICdrStream_skipUnsignedLong (stream)) {
+            goto fin; 
+        }
+
+        if (!RTICdrStream_skipUnsignedLong (stream)) {
+            goto fin; 
+        }
+
+    }
+
+    done = RTI_TRUE;
+  fin:
+    if(!error) {
+        if (done != RTI_TRUE && 
+        RTICdrStream_getRemainder(stream) >=
+        RTI_CDR_PARAMETER_HEADER_ALIGNMENT) {
+            return RTI_FALSE;   
+        }
+    } else {
+        return RTI_FALSE;
+    }       
+
+    if(deserialize_encapsulation) {
+        RTICdrStream_restoreAlignment(stream,position);
+    }
+
+    return RTI_TRUE;
+}
+
+RTIBool 
+TrackerStatusPlugin_instance_to_key(
+    PRESTypePluginEndpointData endpoint_data,
+    TrackerStatusKeyHolder *dst, 
+    const TrackerStatus *src)
+{
+
+    if (endpoint_data) {} /* To avoid warnings */   
+
+    if (!RTICdrType_copyStringEx (
+        &dst->tracker_id, src->tracker_id, 
+        (64) + 1, RTI_FALSE)){
+        return RTI_FALSE;
+    }
+    return RTI_TRUE;
+}
+
+RTIBool 
+TrackerStatusPlugin_key_to_instance(
+    PRESTypePluginEndpointData endpoint_data,
+    TrackerStatus *dst, const
+    TrackerStatusKeyHolder *src)
+{
+
+    if (endpoint_data) {} /* To avoid warnings */   
+    if (!RTICdrType_copyStringEx (
+        &dst->tracker_id, src->tracker_id, 
+        (64) + 1, RTI_FALSE)){
+        return RTI_FALSE;
+    }
+    return RTI_TRUE;
+}
+
+RTIBool 
+TrackerStatusPlugin_instance_to_keyhash(
+    PRESTypePluginEndpointData endpoint_data,
+    DDS_KeyHash_t *keyhash,
+    const TrackerStatus *instance)
+{
+    struct RTICdrStream * md5Stream = NULL;
+    struct RTICdrStreamState cdrState;
+    char * buffer = NULL;
+
+    RTICdrStreamState_init(&cdrState);
+    md5Stream = PRESTypePluginDefaultEndpointData_getMD5Stream(endpoint_data);
+
+    if (md5Stream == NULL) {
+        return RTI_FALSE;
+    }
+
+    RTICdrStream_resetPosition(md5Stream);
+    RTICdrStream_setDirtyBit(md5Stream, RTI_TRUE);
+
+    if (!TrackerStatusPlugin_serialize_key(
+        endpoint_data,
+        instance,
+        md5Stream, 
+        RTI_FALSE, 
+        RTI_CDR_ENCAPSULATION_ID_CDR_BE, 
+        RTI_TRUE,
+        NULL)) 
+    {
+        int size;
+
+        RTICdrStream_pushState(md5Stream, &cdrState, -1);
+
+        size = (int)TrackerStatusPlugin_get_serialized_sample_size(
+            endpoint_data,
+            RTI_FALSE,
+            RTI_CDR_ENCAPSULATION_ID_CDR_BE,
+            0,
+            instance);
+
+        if (size <= RTICdrStream_getBufferLength(md5Stream)) {
+            RTICdrStream_popState(md5Stream, &cdrState);        
+            return RTI_FALSE;
+        }   
+
+        RTIOsapiHeap_allocateBuffer(&buffer,size,0);
+
+        if (buffer == NULL) {
+            RTICdrStream_popState(md5Stream, &cdrState);
+            return RTI_FALSE;
+        }
+
+        RTICdrStream_set(md5Stream, buffer, size);
+        RTIOsapiMemory_zero(
+            RTICdrStream_getBuffer(md5Stream),
+            RTICdrStream_getBufferLength(md5Stream));
+        RTICdrStream_resetPosition(md5Stream);
+        RTICdrStream_setDirtyBit(md5Stream, RTI_TRUE);
+        if (!TrackerStatusPlugin_serialize_key(
+            endpoint_data,
+            instance,
+            md5Stream, 
+            RTI_FALSE, 
+            RTI_CDR_ENCAPSULATION_ID_CDR_BE, 
+            RTI_TRUE,
+            NULL)) 
+        {
+            RTICdrStream_popState(md5Stream, &cdrState);
+            RTIOsapiHeap_freeBuffer(buffer);
+            return RTI_FALSE;
+        }        
+    }   
+
+    if (PRESTypePluginDefaultEndpointData_getMaxSizeSerializedKey(endpoint_data) > 
+    (unsigned int)(MIG_RTPS_KEY_HASH_MAX_LENGTH) ||
+    PRESTypePluginDefaultEndpointData_forceMD5KeyHash(endpoint_data)) {
+        RTICdrStream_computeMD5(md5Stream, keyhash->value);
+    } else {
+        RTIOsapiMemory_zero(keyhash->value,MIG_RTPS_KEY_HASH_MAX_LENGTH);
+        RTIOsapiMemory_copy(
+            keyhash->value, 
+            RTICdrStream_getBuffer(md5Stream), 
+            RTICdrStream_getCurrentPositionOffset(md5Stream));
+    }
+
+    keyhash->length = MIG_RTPS_KEY_HASH_MAX_LENGTH;
+
+    if (buffer != NULL) {
+        RTICdrStream_popState(md5Stream, &cdrState);
+        RTIOsapiHeap_freeBuffer(buffer);
+    }
+
+    return RTI_TRUE;
+}
+
+RTIBool 
+TrackerStatusPlugin_serialized_sample_to_keyhash(
+    PRESTypePluginEndpointData endpoint_data,
+    struct RTICdrStream *stream, 
+    DDS_KeyHash_t *keyhash,
+    RTIBool deserialize_encapsulation,
+    void *endpoint_plugin_qos) 
+{   
+    char * position = NULL;
+
+    RTIBool done = RTI_FALSE;
+    RTIBool error = RTI_FALSE;
+    TrackerStatus * sample=NULL;
+
+    if (endpoint_plugin_qos) {} /* To avoid warnings */
+    if (stream == NULL) {
+        error = RTI_TRUE;
+        goto fin;
+    }
+
+    if(deserialize_encapsulation) {
+        if (!RTICdrStream_deserializeAndSetCdrEncapsulation(stream)) {
+            return RTI_FALSE;
+        }
+
+        position = RTICdrStream_resetAlignment(stream);
+    }
+
+    sample = (TrackerStatus *)
+    PRESTypePluginDefaultEndpointData_getTempSample(endpoint_data);
+
+    if (sample == NULL) {
+        return RTI_FALSE;
+    }
+
+    if (!RTICdrStream_deserializeStringEx(
+        stream,&sample->tracker_id, (64) + 1, RTI_FALSE)) {
+        return RTI_FALSE;
+    }
+    done = RTI_TRUE;
+  fin:
+    if(!error) {
+        if (done != RTI_TRUE && 
+        RTICdrStream_getRemainder(stream) >=
+        RTI_CDR_PARAMETER_HEADER_ALIGNMENT) {
+            return RTI_FALSE;   
+        }
+    } else {
+        return RTI_FALSE;
+    } 
+
+    if(deserialize_encapsulation) {
+        RTICdrStream_restoreAlignment(stream,position);
+    }
+
+    if (!TrackerStatusPlugin_instance_to_keyhash(
+        endpoint_data, keyhash, sample)) {
+        return RTI_FALSE;
+    }
+
+    return RTI_TRUE;
+}
+
+/* ------------------------------------------------------------------------
+* Plug-in Installation Methods
+* ------------------------------------------------------------------------ */
+struct PRESTypePlugin *TrackerStatusPlugin_new(void) 
+{ 
+    struct PRESTypePlugin *plugin = NULL;
+    const struct PRESTypePluginVersion PLUGIN_VERSION = 
+    PRES_TYPE_PLUGIN_VERSION_2_0;
+
+    RTIOsapiHeap_allocateStructure(
+        &plugin, struct PRESTypePlugin);
+
+    if (plugin == NULL) {
+        return NULL;
+    }
+
+    plugin->version = PLUGIN_VERSION;
+
+    /* set up parent's function pointers */
+    plugin->onParticipantAttached =
+    (PRESTypePluginOnParticipantAttachedCallback)
+    TrackerStatusPlugin_on_participant_attached;
+    plugin->onParticipantDetached =
+    (PRESTypePluginOnParticipantDetachedCallback)
+    TrackerStatusPlugin_on_participant_detached;
+    plugin->onEndpointAttached =
+    (PRESTypePluginOnEndpointAttachedCallback)
+    TrackerStatusPlugin_on_endpoint_attached;
+    plugin->onEndpointDetached =
+    (PRESTypePluginOnEndpointDetachedCallback)
+    TrackerStatusPlugin_on_endpoint_detached;
+
+    plugin->copySampleFnc =
+    (PRESTypePluginCopySampleFunction)
+    TrackerStatusPlugin_copy_sample;
+    plugin->createSampleFnc =
+    (PRESTypePluginCreateSampleFunction)
+    TrackerStatusPlugin_create_sample;
+    plugin->destroySampleFnc =
+    (PRESTypePluginDestroySampleFunction)
+    TrackerStatusPlugin_destroy_sample;
+
+    plugin->serializeFnc =
+    (PRESTypePluginSerializeFunction)
+    TrackerStatusPlugin_serialize;
+    plugin->deserializeFnc =
+    (PRESTypePluginDeserializeFunction)
+    TrackerStatusPlugin_deserialize;
+    plugin->getSerializedSampleMaxSizeFnc =
+    (PRESTypePluginGetSerializedSampleMaxSizeFunction)
+    TrackerStatusPlugin_get_serialized_sample_max_size;
+    plugin->getSerializedSampleMinSizeFnc =
+    (PRESTypePluginGetSerializedSampleMinSizeFunction)
+    TrackerStatusPlugin_get_serialized_sample_min_size;
+
+    plugin->getSampleFnc =
+    (PRESTypePluginGetSampleFunction)
+    TrackerStatusPlugin_get_sample;
+    plugin->returnSampleFnc =
+    (PRESTypePluginReturnSampleFunction)
+    TrackerStatusPlugin_return_sample;
+
+    plugin->getKeyKindFnc =
+    (PRESTypePluginGetKeyKindFunction)
+    TrackerStatusPlugin_get_key_kind;
+
+    plugin->getSerializedKeyMaxSizeFnc =   
+    (PRESTypePluginGetSerializedKeyMaxSizeFunction)
+    TrackerStatusPlugin_get_serialized_key_max_size;
+    plugin->serializeKeyFnc =
+    (PRESTypePluginSerializeKeyFunction)
+    TrackerStatusPlugin_serialize_key;
+    plugin->deserializeKeyFnc =
+    (PRESTypePluginDeserializeKeyFunction)
+    TrackerStatusPlugin_deserialize_key;
+    plugin->deserializeKeySampleFnc =
+    (PRESTypePluginDeserializeKeySampleFunction)
+    TrackerStatusPlugin_deserialize_key_sample;
+
+    plugin-> instanceToKeyHashFnc = 
+    (PRESTypePluginInstanceToKeyHashFunction)
+    TrackerStatusPlugin_instance_to_keyhash;
+    plugin->serializedSampleToKeyHashFnc = 
+    (PRESTypePluginSerializedSampleToKeyHashFunction)
+    TrackerStatusPlugin_serialized_sample_to_keyhash;
+
+    plugin->getKeyFnc =
+    (PRESTypePluginGetKeyFunction)
+    TrackerStatusPlugin_get_key;
+    plugin->returnKeyFnc =
+    (PRESTypePluginReturnKeyFunction)
+    TrackerStatusPlugin_return_key;
+
+    plugin->instanceToKeyFnc =
+    (PRESTypePluginInstanceToKeyFunction)
+    TrackerStatusPlugin_instance_to_key;
+    plugin->keyToInstanceFnc =
+    (PRESTypePluginKeyToInstanceFunction)
+    TrackerStatusPlugin_key_to_instance;
+    plugin->serializedKeyToKeyHashFnc = NULL; /* Not supported yet */
+    plugin->typeCode =  (struct RTICdrTypeCode *)TrackerStatus_get_typecode();
+
+    plugin->languageKind = PRES_TYPEPLUGIN_CPP_LANG;
+
+    /* Serialized buffer */
+    plugin->getBuffer = 
+    (PRESTypePluginGetBufferFunction)
+    TrackerStatusPlugin_get_buffer;
+    plugin->returnBuffer = 
+    (PRESTypePluginReturnBufferFunction)
+    TrackerStatusPlugin_return_buffer;
+    plugin->getSerializedSampleSizeFnc =
+    (PRESTypePluginGetSerializedSampleSizeFunction)
+    TrackerStatusPlugin_get_serialized_sample_size;
+
+    plugin->endpointTypeName = TrackerStatusTYPENAME;
+
+    return plugin;
+}
+
+void
+TrackerStatusPlugin_delete(struct PRESTypePlugin *plugin)
+{
+    RTIOsapiHeap_freeStructure(plugin);
+} 
+#undef RTI_CDR_CURRENT_SUBMODULE 
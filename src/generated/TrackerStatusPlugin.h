@@ -0,0 +1,340 @@
+
+
+/*
+WARNING: THIS FILE IS AUTO-GENERATED. DO NOT MODIFY.
+
+This file was generated from TrackerStatus.idl using "rtiddsgen".
+The rtiddsgen tool is part of the RTI Connext distribution.
+For more information, type 'rtiddsgen -help' at a command shell
+or consult the RTI Connext manual.
+*/
+
+#ifndef TrackerStatusPlugin_1390611725_h
+#define TrackerStatusPlugin_1390611725_h
+
+#include "TrackerStatus.h"
+
+struct RTICdrStream;
+
+#ifndef pres_typePlugin_h
+#include "pres/pres_typePlugin.h"
+#endif
+
+#if (defined(RTI_WIN32) || defined (RTI_WINCE)) && defined(NDDS_USER_DLL_EXPORT)
+/* If the code is building on Windows, start exporting symbols.
+*/
+#undef NDDSUSERDllExport
+#define NDDSUSERDllExport __declspec(dllexport)
+#endif
+
+extern "C" {
+
+    /* The type used to store keys for instances of type struct
+    * AnotherSimple.
+    *
+    * By default, this type is struct TrackerStatus
+    * itself. However, if for some reason this choice is not practical for your
+    * system (e.g. if sizeof(struct TrackerStatus)
+    * is very large), you may redefine this typedef in terms of another type of
+    * your choosing. HOWEVER, if you define the KeyHolder type to be something
+    * other than struct AnotherSimple, the
+    * following restriction applies: the key of struct
+    * TrackerStatus must consist of a
+    * single field of your redefined KeyHolder type and that field must be the
+    * first field in struct TrackerStatus.
+    */
+    typedef  class TrackerStatus TrackerStatusKeyHolder;
+
+    #define TrackerStatusPlugin_get_sample PRESTypePluginDefaultEndpointData_getSample 
+    #define TrackerStatusPlugin_get_buffer PRESTypePluginDefaultEndpointData_getBuffer 
+    #define TrackerStatusPlugin_return_buffer PRESTypePluginDefaultEndpointData_returnBuffer 
+
+    #define TrackerStatusPlugin_get_key PRESTypePluginDefaultEndpointData_getKey 
+    #define TrackerStatusPlugin_return_key PRESTypePluginDefaultEndpointData_returnKey
+
+    #define TrackerStatusPlugin_create_sample PRESTypePluginDefaultEndpointData_createSample 
+    #define TrackerStatusPlugin_destroy_sample PRESTypePluginDefaultEndpointData_deleteSample 
+
+    /* --------------------------------------------------------------------------------------
+    Support functions:
+    * -------------------------------------------------------------------------------------- */
+
+    NDDSUSERDllExport extern TrackerStatus*
+    TrackerStatusPluginSupport_create_data_w_params(
+        const struct DDS_TypeAllocationParams_t * alloc_params);
+
+    NDDSUSERDllExport extern TrackerStatus*
+    TrackerStatusPluginSupport_create_data_ex(RTIBool allocate_pointers);
+
+    NDDSUSERDllExport extern TrackerStatus*
+    TrackerStatusPluginSupport_create_data(void);
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPluginSupport_copy_data(
+        TrackerStatus *out,
+        const TrackerStatus *in);
+
+    NDDSUSERDllExport extern void 
+    TrackerStatusPluginSupport_destroy_data_w_params(
+        TrackerStatus *sample,
+        const struct DDS_TypeDeallocationParams_t * dealloc_params);
+
+    NDDSUSERDllExport extern void 
+    TrackerStatusPluginSupport_destroy_data_ex(
+        TrackerStatus *sample,RTIBool deallocate_pointers);
+
+    NDDSUSERDllExport extern void 
+    TrackerStatusPluginSupport_destroy_data(
+        TrackerStatus *sample);
+
+    NDDSUSERDllExport extern void 
+    TrackerStatusPluginSupport_print_data(
+        const TrackerStatus *sample,
+        const char *desc,
+        unsigned int indent);
+
+    NDDSUSERDllExport extern TrackerStatus*
+    TrackerStatusPluginSupport_create_key_ex(RTIBool allocate_pointers);
+
+    NDDSUSERDllExport extern TrackerStatus*
+    TrackerStatusPluginSupport_create_key(void);
+
+    NDDSUSERDllExport extern void 
+    TrackerStatusPluginSupport_destroy_key_ex(
+        TrackerStatusKeyHolder *key,RTIBool deallocate_pointers);
+
+    NDDSUSERDllExport extern void 
+    TrackerStatusPluginSupport_destroy_key(
+        TrackerStatusKeyHolder *key);
+
+    /* ----------------------------------------------------------------------------
+    Callback functions:
+    * ---------------------------------------------------------------------------- */
+
+    NDDSUSERDllExport extern PRESTypePluginParticipantData 
+    TrackerStatusPlugin_on_participant_attached(
+        void *registration_data, 
+        const struct PRESTypePluginParticipantInfo *participant_info,
+        RTIBool top_level_registration, 
+        void *container_plugin_context,
+        RTICdrTypeCode *typeCode);
+
+    NDDSUSERDllExport extern void 
+    TrackerStatusPlugin_on_participant_detached(
+        PRESTypePluginParticipantData participant_data);
+
+    NDDSUSERDllExport extern PRESTypePluginEndpointData 
+    TrackerStatusPlugin_on_endpoint_attached(
+        PRESTypePluginParticipantData participant_data,
+        const struct PRESTypePluginEndpointInfo *endpoint_info,
+        RTIBool top_level_registration, 
+        void *container_plugin_context);
+
+    NDDSUSERDllExport extern void 
+    TrackerStatusPlugin_on_endpoint_detached(
+        PRESTypePluginEndpointData endpoint_data);
+
+    NDDSUSERDllExport extern void    
+    TrackerStatusPlugin_return_sample(
+        PRESTypePluginEndpointData endpoint_data,
+        TrackerStatus *sample,
+        void *handle);    
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_copy_sample(
+        PRESTypePluginEndpointData endpoint_data,
+        TrackerStatus *out,
+        const TrackerStatus *in);
+
+    /* ----------------------------------------------------------------------------
+    (De)Serialize functions:
+    * ------------------------------------------------------------------------- */
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_serialize(
+        PRESTypePluginEndpointData endpoint_data,
+        const TrackerStatus *sample,
+        struct RTICdrStream *stream, 
+        RTIBool serialize_encapsulation,
+        RTIEncapsulationId encapsulation_id,
+        RTIBool serialize_sample, 
+        void *endpoint_plugin_qos);
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_deserialize_sample(
+        PRESTypePluginEndpointData endpoint_data,
+        TrackerStatus *sample, 
+        struct RTICdrStream *stream,
+        RTIBool deserialize_encapsulation,
+        RTIBool deserialize_sample, 
+        void *endpoint_plugin_qos);
+
+    NDDSUSERDllExport extern RTIBool
+    TrackerStatusPlugin_serialize_to_cdr_buffer(
+        char * buffer,
+        unsigned int * length,
+        const TrackerStatus *sample); 
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_deserialize(
+        PRESTypePluginEndpointData endpoint_data,
+        TrackerStatus **sample, 
+        RTIBool * drop_sample,
+        struct RTICdrStream *stream,
+        RTIBool deserialize_encapsulation,
+        RTIBool deserialize_sample, 
+        void *endpoint_plugin_qos);
+
+    NDDSUSERDllExport extern RTIBool
+    TrackerStatusPlugin_deserialize_from_cdr_buffer(
+        TrackerStatus *sample,
+        const char * buffer,
+        unsigned int length);    
+    NDDSUSERDllExport extern DDS_ReturnCode_t
+    TrackerStatusPlugin_data_to_string(
+        const TrackerStatus *sample,
+        char *str,
+        DDS_UnsignedLong *str_size, 
+        const struct DDS_PrintFormatProperty *property);    
+
+    NDDSUSERDllExport extern RTIBool
+    TrackerStatusPlugin_skip(
+        PRESTypePluginEndpointData endpoint_data,
+        struct RTICdrStream *stream, 
+        RTIBool skip_encapsulation,  
+        RTIBool skip_sample, 
+        void *endpoint_plugin_qos);
+
+    NDDSUSERDllExport extern unsigned int 
+    TrackerStatusPlugin_get_serialized_sample_max_size_ex(
+        PRESTypePluginEndpointData endpoint_data,
+        RTIBool * overflow,
+        RTIBool include_encapsulation,
+        RTIEncapsulationId encapsulation_id,
+        unsigned int current_alignment);    
+
+    NDDSUSERDllExport extern unsigned int 
+    TrackerStatusPlugin_get_serialized_sample_max_size(
+        PRESTypePluginEndpointData endpoint_data,
+        RTIBool include_encapsulation,
+        RTIEncapsulationId encapsulation_id,
+        unsigned int current_alignment);
+
+    NDDSUSERDllExport extern unsigned int 
+    TrackerStatusPlugin_get_serialized_sample_min_size(
+        PRESTypePluginEndpointData endpoint_data,
+        RTIBool include_encapsulation,
+        RTIEncapsulationId encapsulation_id,
+        unsigned int current_alignment);
+
+    NDDSUSERDllExport extern unsigned int
+    TrackerStatusPlugin_get_serialized_sample_size(
+        PRESTypePluginEndpointData endpoint_data,
+        RTIBool include_encapsulation,
+        RTIEncapsulationId encapsulation_id,
+        unsigned int current_alignment,
+        const TrackerStatus * sample);
+
+    /* --------------------------------------------------------------------------------------
+    Key Management functions:
+    * -------------------------------------------------------------------------------------- */
+    NDDSUSERDllExport extern PRESTypePluginKeyKind 
+    TrackerStatusPlugin_get_key_kind(void);
+
+    NDDSUSERDllExport extern unsigned int 
+    TrackerStatusPlugin_get_serialized_key_max_size_ex(
+        PRESTypePluginEndpointData endpoint_data,
+        RTIBool * overflow,
+        RTIBool include_encapsulation,
+        RTIEncapsulationId encapsulation_id,
+        unsigned int current_alignment);
+
+    NDDSUSERDllExport extern unsigned int 
+    TrackerStatusPlugin_get_serialized_key_max_size(
+        PRESTypePluginEndpointData endpoint_data,
+        RTIBool include_encapsulation,
+        RTIEncapsulationId encapsulation_id,
+        unsigned int current_alignment);
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_serialize_key(
+        PRESTypePluginEndpointData endpoint_data,
+        const TrackerStatus *sample,
+        struct RTICdrStream *stream,
+        RTIBool serialize_encapsulation,
+        RTIEncapsulationId encapsulation_id,
+        RTIBool serialize_key,
+        void *endpoint_plugin_qos);
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_deserialize_key_sample(
+        PRESTypePluginEndpointData endpoint_data,
+        TrackerStatus * sample,
+        struct RTICdrStream *stream,
+        RTIBool deserialize_encapsulation,
+        RTIBool deserialize_key,
+        void *endpoint_plugin_qos);
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_deserialize_key(
+        PRESTypePluginEndpointData endpoint_data,
+        TrackerStatus ** sample,
+        RTIBool * drop_sample,
+        struct RTICdrStream *stream,
+        RTIBool deserialize_encapsulation,
+        RTIBool deserialize_key,
+        void *endpoint_plugin_qos);
+
+    NDDSUSERDllExport extern RTIBool
+    TrackerStatusPlugin_serialized_sample_to_key(
+        PRESTypePluginEndpointData endpoint_data,
+        TrackerStatus *sample,
+        struct RTICdrStream *stream, 
+        RTIBool deserialize_encapsulation,  
+        RTIBool deserialize_key, 
+        void *endpoint_plugin_qos);
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_instance_to_key(
+        PRESTypePluginEndpointData endpoint_data,
+        TrackerStatusKeyHolder *key, 
+        const TrackerStatus *instance);
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_key_to_instance(
+        PRESTypePluginEndpointData endpoint_data,
+        TrackerStatus *instance, 
+        const TrackerStatusKeyHolder *key);
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_instance_to_keyhash(
+        PRESTypePluginEndpointData endpoint_data,
+        DDS_KeyHash_t *keyhash,
+        const TrackerStatus *instance);
+
+    NDDSUSERDllExport extern RTIBool 
+    TrackerStatusPlugin_serialized_sample_to_keyhash(
+        PRESTypePluginEndpointData endpoint_data,
+        struct RTICdrStream *stream, 
+        DDS_KeyHash_t *keyhash,
+        RTIBool deserialize_encapsulation,
+        void *endpoint_plugin_qos); 
+
+    /* Plugin Functions */
+    NDDSUSERDllExport extern struct PRESTypePlugin*
+    TrackerStatusPlugin_new(void);
+
+    NDDSUSERDllExport extern void
+    TrackerStatusPlugin_delete(struct PRESTypePlugin *);
+
+}
+
+#if (defined(RTI_WIN32) || defined (RTI_WINCE)) && defined(NDDS_USER_DLL_EXPORT)
+/* If the code is building on Windows, stop exporting symbols.
+*/
+#undef NDDSUSERDllExport
+#define NDDSUSERDllExport
+#endif
+
+#endif /* TrackerStatusPlugin_1390611725_h */
+
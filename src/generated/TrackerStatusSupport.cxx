@@ -0,0 +1,117 @@
+
+/*
+WARNING: THIS FILE IS AUTO-GENERATED. DO NOT MODIFY.
+
+This file was generated from TrackerStatus.idl using "rtiddsgen".
+The rtiddsgen tool is part of the RTI Connext distribution.
+For more information, type 'rtiddsgen -help' at a command shell
+or consult the RTI Connext manual.
+*/
+
+#include "TrackerStatusSupport.h"
+#include "TrackerStatusPlugin.h"
+
+#ifndef dds_c_log_impl_h              
+#include "dds_c/dds_c_log_impl.h"                                
+#endif        
+
+/* ========================================================================= */
+/**
+<<IMPLEMENTATION>>
+
+Defines:   TData,
+TDataWriter,
+TDataReader,
+TTypeSupport
+
+Configure and implement 'TrackerStatus' support classes.
+
+Note: Only the #defined classes get defined
+*/
+
+/* ----------------------------------------------------------------- */
+/* DDSDataWriter
+*/
+
+/**
+<<IMPLEMENTATION >>
+
+Defines:   TDataWriter, TData
+*/
+
+/* Requires */
+#define TTYPENAME   TrackerStatusTYPENAME
+
+/* Defines */
+#define TDataWriter TrackerStatusDataWriter
+#define TData       TrackerStatus
+
+#include "dds_cpp/generic/dds_cpp_data_TDataWriter.gen"
+
+#undef TDataWriter
+#undef TData
+
+#undef TTYPENAME
+
+/* ----------------------------------------------------------------- */
+/* DDSDataReader
+*/
+
+/**
+<<IMPLEMENTATION >>
+
+Defines:   TDataReader, TDataSeq, TData
+*/
+
+/* Requires */
+#define TTYPENAME   TrackerStatusTYPENAME
+
+/* Defines */
+#define TDataReader TrackerStatusDataReader
+#define TDataSeq    TrackerStatusSeq
+#define TData       TrackerStatus
+
+#include "dds_cpp/generic/dds_cpp_data_TDataReader.gen"
+
+#undef TDataReader
+#undef TDataSeq
+#undef TData
+
+#undef TTYPENAME
+
+/* ----------------------------------------------------------------- */
+/* TypeSupport
+
+<<IMPLEMENTATION >>
+
+Requires:  TTYPENAME,
+TPlugin_new
+TPlugin_delete
+Defines:   TTypeSupport, TData, TDataReader, TDataWriter
+*/
+
+/* Requires */
+#define TTYPENAME    TrackerStatusTYPENAME
+#define TPlugin_new  TrackerStatusPlugin_new
+#define TPlugin_delete  TrackerStatusPlugin_delete
+
+/* Defines */
+#define TTypeSupport TrackerStatusTypeSupport
+#define TData        TrackerStatus
+#define TDataReader  TrackerStatusDataReader
+#define TDataWriter  TrackerStatusDataWriter
+#define TGENERATE_SER_CODE
+#define TGENERATE_TYPECODE
+
+#include "dds_cpp/generic/dds_cpp_data_TTypeSupport.gen"
+
+#undef TTypeSupport
+#undef TData
+#undef TDataReader
+#undef TDataWriter
+#undef TGENERATE_TYPECODE
+#undef TGENERATE_SER_CODE
+#undef TTYPENAME
+#undef TPlugin_new
+#undef TPlugin_delete
+
@@ -0,0 +1,62 @@
+
+/*
+WARNING: THIS FILE IS AUTO-GENERATED. DO NOT MODIFY.
+
+This file was generated from TrackerStatus.idl using "rtiddsgen".
+The rtiddsgen tool is part of the RTI Connext distribution.
+For more information, type 'rtiddsgen -help' at a command shell
+or consult the RTI Connext manual.
+*/
+
+#ifndef TrackerStatusSupport_1390611725_h
+#define TrackerStatusSupport_1390611725_h
+
+/* Uses */
+#include "TrackerStatus.h"
+
+#ifndef ndds_cpp_h
+#include "ndds/ndds_cpp.h"
+#endif
+
+#if (defined(RTI_WIN32) || defined (RTI_WINCE)) && defined(NDDS_USER_DLL_EXPORT)
+
+class __declspec(dllimport) DDSTypeSupport;
+class __declspec(dllimport) DDSDataWriter;
+class __declspec(dllimport) DDSDataReader;
+
+#endif
+
+/* ========================================================================= */
+/**
+Uses:     T
+
+Defines:  TTypeSupport, TDataWriter, TDataReader
+
+Organized using the well-documented "Generics Pattern" for
+implementing generics in C and C++.
+*/
+
+#if (defined(RTI_WIN32) || defined (RTI_WINCE)) && defined(NDDS_USER_DLL_EXPORT)
+/* If the code is building on Windows, start exporting symbols.
+*/
+#undef NDDSUSERDllExport
+#define NDDSUSERDllExport __declspec(dllexport)
+
+#endif
+
+DDS_TYPESUPPORT_CPP(
+    TrackerStatusTypeSupport, 
+    TrackerStatus);
+
+DDS_DATAWRITER_CPP(TrackerStatusDataWriter, TrackerStatus);
+DDS_DATAREADER_CPP(TrackerStatusDataReader, TrackerStatusSeq, TrackerStatus);
+
+#if (defined(RTI_WIN32) || defined (RTI_WINCE)) && defined(NDDS_USER_DLL_EXPORT)
+/* If the code is building on Windows, stop exporting symbols.
+*/
+#undef NDDSUSERDllExport
+#define NDDSUSERDllExport
+#endif
+
+#endif  /* TrackerStatusSupport_1390611725_h */
+
@@ -0,0 +1,59 @@
+#include <string.h>
+#include "gimbal_head.h"
+#include "gimbal.h"
+
+static const char *lawNames[] = { "p", "pd", "pid", "pid-aw", "p-float", "pd-float", "pid-float", "pid-aw-float" };
+
+//-------------------------------------------------------------------
+// Setup the gimbal control structures
+//-------------------------------------------------------------------
+void initialize_gimbals(struct Gimbal *pan, struct Gimbal *tilt)
+{
+	gimbal_axis_init<PanAxis>(pan);
+	gimbal_axis_init<TiltAxis>(tilt);
+}
+
+//-------------------------------------------------------------------
+// This is the control loop for each axis of the cam control (pan/tilt).
+// Both axes share the RC servo limits, so one instance serves either;
+// the law is the one selected in the gimbal.
+//-------------------------------------------------------------------
+void gimbal_update(struct Gimbal *  gimbal, int32_t error, int32_t interval_us)
+{
+	gimbal_axis_update<RcServoAxis>(gimbal, error, interval_us);
+}
+
+//-------------------------------------------------------------------
+// Hysteresis: the band to compare with depends on whether the axis
+// is already holding
+//-------------------------------------------------------------------
+bool gimbal_hold(struct Gimbal *gimbal, int32_t error)
+{
+	int32_t magnitude = (error < 0) ? -error : error;
+
+	if (gimbal->dead_band <= 0)
+		return false;
+
+	gimbal->holding = (magnitude <= (gimbal->holding ? gimbal->dead_band_exit : gimbal->dead_band));
+	if (gimbal->holding)
+		gimbal->previous_error = error;
+
+	return gimbal->holding;
+}
+
+const char *gimbal_law_name(int law)
+{
+	if ((law < 0) || (law >= (int) (sizeof(lawNames) / sizeof(lawNames[0]))))
+		return "?";
+	return lawNames[law];
+}
+
+int gimbal_law_parse(const char *name)
+{
+	int law;
+
+	for (law = 0; law < (int) (sizeof(lawNames) / sizeof(lawNames[0])); law++)
+		if (strcmp(name, lawNames[law]) == 0)
+			return law;
+	return -1;
+}
@@ -0,0 +1,137 @@
+//-------------------------------------------------------------------
+// gimbal.h - per-axis controller driving the pan/tilt servos
+//
+// No DDS in here, so the tracker loop and the replay tool run the
+// same controller.  The laws are templates over the axis' limits in
+// gimbal_law.h; the tracker drives whole heads through them
+// (gimbal_head.h).
+//-------------------------------------------------------------------
+#ifndef GIMBAL_H
+#define GIMBAL_H
+
+#include <stdint.h>
+
+// RC-servo values
+#define PIXY_RCS_MIN_POS            0
+#define PIXY_RCS_MAX_POS            1000
+#define PIXY_RCS_CENTER_POS         ((PIXY_RCS_MAX_POS-PIXY_RCS_MIN_POS)/2)
+
+// PID control parameters //
+//#define PAN_PROPORTIONAL_GAIN     400	// 400 350
+//#define PAN_DERIVATIVE_GAIN       300	// 300 600
+//#define TILT_PROPORTIONAL_GAIN    500	// 500 500
+//#define TILT_DERIVATIVE_GAIN      300	// 400 700
+
+// Bounds on the sample interval seen by the derivative: bunched
+// samples must not divide by ~0, and after a gap the error change
+// says nothing about the target's speed.
+#define GIMBAL_MIN_INTERVAL_US     2000
+#define GIMBAL_MAX_INTERVAL_US     250000
+#define GIMBAL_DEFAULT_INTERVAL_US 20000   // used when the interval is unknown
+#define GIMBAL_DELTA_FRACTION_BITS 4
+
+// previous_error when there is none to differentiate against
+#define GIMBAL_NO_ERROR            INT32_MIN
+
+// Gains in real units: servo units moved per pixel of error each
+// update (P), per pixel of error change (D), and per pixel second of
+// error (I, PID laws only).  The float laws use these; the fixed-point
+// laws get them in Q10, rounded at compile time.
+#define PAN_PROPORTIONAL          0.293	// Q10 300 (400 350)
+#define PAN_DERIVATIVE            0.195	// Q10 200 (300 600)
+#define PAN_INTEGRAL              1.95
+#define TILT_PROPORTIONAL         0.342	// Q10 350 (500 500)
+#define TILT_DERIVATIVE           0.293	// Q10 300 (400 700)
+#define TILT_INTEGRAL             1.95
+
+constexpr int32_t gimbal_q10(double gain)
+{
+  return (int32_t) (gain * 1024 + ((gain < 0) ? -0.5 : 0.5));
+}
+
+// The fixed-point integral runs in GIMBAL_DEFAULT_INTERVAL_US steps
+constexpr int32_t gimbal_integral_q10(double gain)
+{
+  return gimbal_q10(gain * GIMBAL_DEFAULT_INTERVAL_US / 1000000.0);
+}
+
+#define PAN_PROPORTIONAL_GAIN     gimbal_q10(PAN_PROPORTIONAL)
+#define PAN_DERIVATIVE_GAIN       gimbal_q10(PAN_DERIVATIVE)
+#define PAN_INTEGRAL_GAIN         gimbal_integral_q10(PAN_INTEGRAL)
+#define TILT_PROPORTIONAL_GAIN    gimbal_q10(TILT_PROPORTIONAL)
+#define TILT_DERIVATIVE_GAIN      gimbal_q10(TILT_DERIVATIVE)
+#define TILT_INTEGRAL_GAIN        gimbal_integral_q10(TILT_INTEGRAL)
+
+static_assert(((PAN_PROPORTIONAL == 0) || (PAN_PROPORTIONAL_GAIN != 0)) && ((PAN_DERIVATIVE == 0) || (PAN_DERIVATIVE_GAIN != 0))
+    && ((PAN_INTEGRAL == 0) || (PAN_INTEGRAL_GAIN != 0)) && ((TILT_PROPORTIONAL == 0) || (TILT_PROPORTIONAL_GAIN != 0))
+    && ((TILT_DERIVATIVE == 0) || (TILT_DERIVATIVE_GAIN != 0)) && ((TILT_INTEGRAL == 0) || (TILT_INTEGRAL_GAIN != 0)),
+    "a gain rounds to zero in Q10");
+
+// Nominal servo units per Shapes pixel: ~75x47 degree lens over the
+// Shapes frame, ~180 degrees of servo travel over PIXY_RCS_MAX_POS.
+// Used to place the target in servo coordinates for prediction and
+// as the ideal-lens scale for calibration tables.
+#define PAN_SERVO_PER_PIXEL_Q10    1946
+#define TILT_SERVO_PER_PIXEL_Q10   1061
+
+// Controller laws (gimbal_law.h) selectable at startup
+enum GimbalLaw {
+  GIMBAL_LAW_P,
+  GIMBAL_LAW_PD,                  // the default
+  GIMBAL_LAW_PID,
+  GIMBAL_LAW_PID_ANTI_WINDUP,
+  GIMBAL_LAW_P_FLOAT,             // the same laws in float arithmetic
+  GIMBAL_LAW_PD_FLOAT,
+  GIMBAL_LAW_PID_FLOAT,
+  GIMBAL_LAW_PID_ANTI_WINDUP_FLOAT
+};
+
+// State of the float laws; position keeps the fraction that
+// Gimbal::position rounds off
+struct GimbalFloat {
+  float proportional_gain;       // real units, see PAN_PROPORTIONAL
+  float derivative_gain;
+  float integral_gain;
+  float position;
+  float filtered_delta;          // pixels
+  float integral;                // pixel seconds
+};
+
+//-------------------------------------------------------------------
+// We'll need one of these for pan, and one for tilt.  Holds
+// variables for running the tracking algorithm
+//-------------------------------------------------------------------
+struct Gimbal {
+  int32_t position;
+  int32_t previous_error;
+  int32_t proportional_gain;
+  int32_t derivative_gain;
+  int32_t integral_gain;         // PID laws only
+  int32_t integral;              // Q4 error x GIMBAL_DEFAULT_INTERVAL_US
+  bool    integral_valid;        // false: the next update starts the integral afresh
+  int32_t derivative_period_us;  // D gain is tuned for this interval; 0 = per sample
+  int32_t derivative_filter_us;  // low-pass time constant on the D input; 0 = off
+  int32_t filtered_delta;        // Q4
+  int32_t dead_band;             // |error| at or below this starts holding; 0 = off
+  int32_t dead_band_exit;        // and above this ends it (>= dead_band)
+  bool    holding;
+  int     law;                   // enum GimbalLaw, for SelectedLaw
+  struct GimbalFloat floating;
+};
+
+void initialize_gimbals(struct Gimbal *pan, struct Gimbal *tilt);
+void gimbal_update(struct Gimbal *gimbal, int32_t error, int32_t interval_us);
+
+// -law names ("p", "pd", "pid", "pid-aw", each also with "-float");
+// parse returns -1 if unknown
+const char *gimbal_law_name(int law);
+int gimbal_law_parse(const char *name);
+
+// Dead band with hysteresis around the setpoint.  Returns true while
+// the axis should hold its position instead of calling gimbal_update:
+// from the error dropping to dead_band until it exceeds
+// dead_band_exit.  The previous error still follows, so the D term
+// does not see the whole hold as one step on leaving.
+bool gimbal_hold(struct Gimbal *gimbal, int32_t error);
+
+#endif
@@ -0,0 +1,250 @@
+//-------------------------------------------------------------------
+// gimbal_head.h - N-axis gimbal head with compile-time axis policies
+//
+// A head policy gives its axis count and, per axis, a policy class
+// with the servo limits, the image-to-servo scale, the default gains
+// as constants (real units, and Q10 for the fixed-point laws) and the
+// controller law (gimbal_law.h).  A pan/tilt/zoom rig would be
+//
+//   struct ZoomAxis : RcServoAxis {
+//       enum { SERVO_PER_PIXEL_Q10 = ..., PROPORTIONAL_GAIN = gimbal_q10(0.2), ... };
+//       static constexpr float PROPORTIONAL = 0.2; ...
+//       typedef PidAntiWindupLaw Law;
+//   };
+//   struct PanTiltZoomHead { enum { AXES = 3 }; template <int A> struct Axis; };
+//   template <> struct PanTiltZoomHead::Axis<0> : PanAxis {};
+//   template <> struct PanTiltZoomHead::Axis<1> : TiltAxis {};
+//   template <> struct PanTiltZoomHead::Axis<2> : ZoomAxis {};
+//
+// GimbalHead<Head> holds one Gimbal per axis.  The per-axis loops
+// unroll by template recursion with every limit and scale a constant,
+// so the pan/tilt head compiles to the same code as the two
+// hand-written gimbal_update() calls it replaces, and nothing is
+// virtual.  Run-time settings (derivative timing, dead band, the law
+// for axes using SelectedLaw) stay in each axis' Gimbal.
+//-------------------------------------------------------------------
+#ifndef GIMBAL_HEAD_H
+#define GIMBAL_HEAD_H
+
+#include <stdint.h>
+#include "tracker_probes.h"
+#include "gimbal.h"
+#include "gimbal_law.h"
+
+//-------------------------------------------------------------------
+// Axis policies
+//-------------------------------------------------------------------
+struct RcServoAxis {
+	enum {
+		MIN_POS    = PIXY_RCS_MIN_POS,
+		MAX_POS    = PIXY_RCS_MAX_POS,
+		CENTER_POS = PIXY_RCS_CENTER_POS
+	};
+	typedef SelectedLaw Law;
+};
+
+struct PanAxis : RcServoAxis {
+	enum {
+		SERVO_PER_PIXEL_Q10 = PAN_SERVO_PER_PIXEL_Q10,
+		PROPORTIONAL_GAIN   = PAN_PROPORTIONAL_GAIN,
+		DERIVATIVE_GAIN     = PAN_DERIVATIVE_GAIN,
+		INTEGRAL_GAIN       = PAN_INTEGRAL_GAIN
+	};
+	static constexpr float PROPORTIONAL = PAN_PROPORTIONAL;
+	static constexpr float DERIVATIVE   = PAN_DERIVATIVE;
+	static constexpr float INTEGRAL     = PAN_INTEGRAL;
+};
+
+struct TiltAxis : RcServoAxis {
+	enum {
+		SERVO_PER_PIXEL_Q10 = TILT_SERVO_PER_PIXEL_Q10,
+		PROPORTIONAL_GAIN   = TILT_PROPORTIONAL_GAIN,
+		DERIVATIVE_GAIN     = TILT_DERIVATIVE_GAIN,
+		INTEGRAL_GAIN       = TILT_INTEGRAL_GAIN
+	};
+	static constexpr float PROPORTIONAL = TILT_PROPORTIONAL;
+	static constexpr float DERIVATIVE   = TILT_DERIVATIVE;
+	static constexpr float INTEGRAL     = TILT_INTEGRAL;
+};
+
+// The Pixy rig
+enum { GIMBAL_PAN, GIMBAL_TILT };
+
+struct PanTiltHead {
+	enum { AXES = 2 };
+	template <int A> struct Axis;
+};
+template <> struct PanTiltHead::Axis<GIMBAL_PAN>  : PanAxis {};
+template <> struct PanTiltHead::Axis<GIMBAL_TILT> : TiltAxis {};
+
+//-------------------------------------------------------------------
+// One axis
+//-------------------------------------------------------------------
+template <class Axis>
+static inline void gimbal_axis_init(struct Gimbal *gimbal)
+{
+	gimbal->position          = Axis::CENTER_POS;
+	gimbal->previous_error    = GIMBAL_NO_ERROR;
+	gimbal->proportional_gain = Axis::PROPORTIONAL_GAIN;
+	gimbal->derivative_gain   = Axis::DERIVATIVE_GAIN;
+	gimbal->integral_gain     = Axis::INTEGRAL_GAIN;
+	gimbal->integral          = 0;
+	gimbal->integral_valid    = false;
+	gimbal->derivative_period_us = 0;
+	gimbal->derivative_filter_us = 0;
+	gimbal->filtered_delta    = 0;
+	gimbal->dead_band         = 0;
+	gimbal->dead_band_exit    = 0;
+	gimbal->holding           = false;
+	gimbal->law               = GIMBAL_LAW_PD;
+	gimbal->floating.proportional_gain = Axis::PROPORTIONAL;
+	gimbal->floating.derivative_gain   = Axis::DERIVATIVE;
+	gimbal->floating.integral_gain     = Axis::INTEGRAL;
+	gimbal->floating.position          = Axis::CENTER_POS;
+	gimbal->floating.filtered_delta    = 0;
+	gimbal->floating.integral          = 0;
+}
+
+// Image error (pixels) to a servo offset, and back
+template <class Axis>
+static inline int32_t gimbal_axis_to_servo(int32_t error)
+{
+	return (error * Axis::SERVO_PER_PIXEL_Q10) >> 10;
+}
+
+template <class Axis>
+static inline int32_t gimbal_axis_to_error(int32_t offset)
+{
+	return offset * 1024 / Axis::SERVO_PER_PIXEL_Q10;
+}
+
+// One step of the axis' law, clamped to the axis' limits
+template <class Axis>
+static inline void gimbal_axis_update(struct Gimbal *gimbal, int32_t error, int32_t interval_us)
+{
+	Axis::Law::template update<Axis>(gimbal, error, interval_us);
+}
+
+// The same for axis number `axis` of a head, with the gimbal_update
+// probe: the head's label, the source timestamp of the observation
+// behind the error (0 for coasting) and the error the step replaced
+template <class Axis>
+static inline void gimbal_axis_step(struct Gimbal *gimbal, int axis, int32_t error, int32_t interval_us,
+		const char *label, int64_t source_us)
+{
+	int32_t previous_error = gimbal->previous_error;
+
+	gimbal_axis_update<Axis>(gimbal, error, interval_us);
+	TRACKER_PROBE7(gimbal_update, label, axis, error, interval_us, gimbal->position, previous_error, source_us);
+	(void) previous_error;
+}
+
+//-------------------------------------------------------------------
+// All axes: GimbalHeadLoop<Head, N> handles axis AXES - N and recurses
+//-------------------------------------------------------------------
+template <class Head, int REMAINING>
+struct GimbalHeadLoop {
+	enum { A = Head::AXES - REMAINING };
+	typedef typename Head::template Axis<A> Axis;
+	typedef GimbalHeadLoop<Head, REMAINING - 1> Next;
+
+	static inline void init(struct Gimbal *gimbal)
+	{
+		gimbal_axis_init<Axis>(&gimbal[A]);
+		Next::init(gimbal);
+	}
+
+	static inline void update(struct Gimbal *gimbal, const int32_t *error, int32_t interval_us,
+			const char *label, int64_t source_us)
+	{
+		gimbal_axis_step<Axis>(&gimbal[A], A, error[A], interval_us, label, source_us);
+		Next::update(gimbal, error, interval_us, label, source_us);
+	}
+
+	static inline unsigned int track(struct Gimbal *gimbal, const int32_t *error, int32_t interval_us,
+			const char *label, int64_t source_us)
+	{
+		unsigned int held = gimbal_hold(&gimbal[A], error[A]) ? (1u << A) : 0;
+
+		if (!held)
+			gimbal_axis_step<Axis>(&gimbal[A], A, error[A], interval_us, label, source_us);
+		return held | Next::track(gimbal, error, interval_us, label, source_us);
+	}
+
+	static inline void to_servo(const struct Gimbal *gimbal, const int32_t *error, int32_t *servo)
+	{
+		servo[A] = gimbal[A].position + gimbal_axis_to_servo<Axis>(error[A]);
+		Next::to_servo(gimbal, error, servo);
+	}
+
+	static inline void to_error(const struct Gimbal *gimbal, const int32_t *servo, int32_t *error)
+	{
+		error[A] = gimbal_axis_to_error<Axis>(servo[A] - gimbal[A].position);
+		Next::to_error(gimbal, servo, error);
+	}
+};
+
+template <class Head>
+struct GimbalHeadLoop<Head, 0> {
+	static inline void init(struct Gimbal *) {}
+	static inline void update(struct Gimbal *, const int32_t *, int32_t, const char *, int64_t) {}
+	static inline unsigned int track(struct Gimbal *, const int32_t *, int32_t, const char *, int64_t) { return 0; }
+	static inline void to_servo(const struct Gimbal *, const int32_t *, int32_t *) {}
+	static inline void to_error(const struct Gimbal *, const int32_t *, int32_t *) {}
+};
+
+template <class Head>
+struct GimbalHead {
+	enum { ALL_HELD = (1 << Head::AXES) - 1 };
+	struct Gimbal axis[Head::AXES];
+	const char *label;              // gimbal_update probe arg0, e.g. the metrics label
+};
+
+template <class Head>
+static inline void gimbal_head_init(GimbalHead<Head> *head)
+{
+	GimbalHeadLoop<Head, Head::AXES>::init(head->axis);
+	head->label = "";
+}
+
+// Every axis steps toward its error.  source_us is the source
+// timestamp of the observation behind it, 0 if none; only the probe
+// uses it.
+template <class Head>
+static inline void gimbal_head_update(GimbalHead<Head> *head, const int32_t error[], int32_t interval_us, int64_t source_us)
+{
+	GimbalHeadLoop<Head, Head::AXES>::update(head->axis, error, interval_us, head->label, source_us);
+}
+
+// As gimbal_head_update, but axes inside their dead band hold.
+// Returns the held axes as a bit mask (bit A for axis A).
+template <class Head>
+static inline unsigned int gimbal_head_track(GimbalHead<Head> *head, const int32_t error[], int32_t interval_us,
+		int64_t source_us)
+{
+	return GimbalHeadLoop<Head, Head::AXES>::track(head->axis, error, interval_us, head->label, source_us);
+}
+
+// While the target is not tracked the PID laws must not integrate
+template <class Head>
+static inline void gimbal_head_reset_integral(GimbalHead<Head> *head)
+{
+	for (int a = 0; a < Head::AXES; a++)
+		gimbal_reset_integral(&head->axis[a]);
+}
+
+// Where an image error puts the target in servo coordinates
+template <class Head>
+static inline void gimbal_head_to_servo(const GimbalHead<Head> *head, const int32_t error[], int32_t servo[])
+{
+	GimbalHeadLoop<Head, Head::AXES>::to_servo(head->axis, error, servo);
+}
+
+// The error that aims each axis at a servo-coordinate target
+template <class Head>
+static inline void gimbal_head_to_error(const GimbalHead<Head> *head, const int32_t servo[], int32_t error[])
+{
+	GimbalHeadLoop<Head, Head::AXES>::to_error(head->axis, servo, error);
+}
+
+#endif
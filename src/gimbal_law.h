@@ -0,0 +1,344 @@
+//-------------------------------------------------------------------
+// gimbal_law.h - controller laws for one gimbal axis
+//
+// Every law is a class with one static member template,
+//
+//   template <class Axis>
+//   static void update(struct Gimbal *gimbal, int32_t error, int32_t interval_us);
+//
+// that moves gimbal->position to reduce the error and clamps it to
+// Axis::MIN_POS..Axis::MAX_POS.  An axis policy fixes its law at
+// compile time ("typedef PidLaw Law;"); SelectedLaw switches on
+// gimbal->law, set at startup, over the same instances.
+//
+//   PLaw              position += P e
+//   PdLaw             position += P e + D de   (the original law)
+//   PidLaw            PdLaw + I sum(e dt)
+//   PidAntiWindupLaw  PidLaw that does not integrate while the
+//                     position is clamped and the error pushes it
+//                     further, and bounds the I term to the travel
+//
+// The laws are incremental: the position already accumulates P e, so
+// the I term is what removes the steady lag behind a target moving at
+// constant speed.  Gains are Q10, the integral Q4 pixel-intervals of
+// GIMBAL_DEFAULT_INTERVAL_US.  interval_us is the time since the
+// previous error sample (0 if not known, see gimbal_source_interval());
+// at GIMBAL_MAX_INTERVAL_US it is a gap, which the D term ignores and
+// the I step counts no further than that.
+// The loop calls gimbal_reset_integral() whenever the target is not
+// tracked, and the first update after that does not integrate: the
+// gap it closes was either coasted (and integrated) or not observed.
+//
+// FloatPLaw ... FloatPidAntiWindupLaw are the same laws in float with
+// the gains in real units (Gimbal::floating), for boards with an FPU
+// and for filters that are awkward in Q10.  They keep the fractional
+// position and round it into Gimbal::position; a position set from
+// outside (search, calibration) is taken over.
+//-------------------------------------------------------------------
+#ifndef GIMBAL_LAW_H
+#define GIMBAL_LAW_H
+
+#include <stdint.h>
+#include "gimbal.h"
+
+#define GIMBAL_INTEGRAL_FRACTION_BITS 4
+#define GIMBAL_INTEGRAL_GUARD         (1 << 24)  // keeps a winding-up PidLaw in range
+
+static inline bool gimbal_error_valid(const struct Gimbal *gimbal)
+{
+	return gimbal->previous_error != GIMBAL_NO_ERROR;
+}
+
+// Empties the integral; the next update starts it without a step
+static inline void gimbal_reset_integral(struct Gimbal *gimbal)
+{
+	gimbal->integral = 0;
+	gimbal->floating.integral = 0;
+	gimbal->integral_valid = false;
+}
+
+// The interval an I step integrates over
+static inline int32_t gimbal_integral_interval(struct Gimbal *gimbal, int32_t interval_us)
+{
+	if (!gimbal->integral_valid)
+	{
+		gimbal->integral_valid = true;
+		return 0;
+	}
+	return (interval_us > GIMBAL_MAX_INTERVAL_US) ? GIMBAL_MAX_INTERVAL_US : interval_us;
+}
+
+// Whether an integral step of this sign, times the gain, drives the
+// position up (direction > 0) or down; signs only, nothing to overflow
+static inline bool gimbal_step_drives(int32_t step, int32_t gain, int direction)
+{
+	if ((step == 0) || (gain == 0))
+		return false;
+	return ((step > 0) == (gain > 0)) == (direction > 0);
+}
+
+// The interval between two source timestamps, 0 when there is no
+// previous one.  Clamped while still 64 bits, so a long silence is a
+// gap rather than a wrapped (negative) interval.
+static inline int32_t gimbal_source_interval(int64_t source_us, int64_t last_source_us)
+{
+	int64_t interval_us = source_us - last_source_us;
+
+	if ((last_source_us == 0) || (interval_us <= 0))
+		return 0;
+	return (interval_us > GIMBAL_MAX_INTERVAL_US) ? GIMBAL_MAX_INTERVAL_US : (int32_t) interval_us;
+}
+
+static inline int32_t gimbal_interval(const struct Gimbal *gimbal, int32_t interval_us)
+{
+	if (interval_us <= 0)
+		return (gimbal->derivative_period_us > 0) ? gimbal->derivative_period_us : GIMBAL_DEFAULT_INTERVAL_US;
+	return (interval_us < GIMBAL_MIN_INTERVAL_US) ? GIMBAL_MIN_INTERVAL_US : interval_us;
+}
+
+//-------------------------------------------------------------------
+// D contribution before the final >> 10: the error change rescaled to
+// the interval the D gain was tuned for, optionally low-passed
+//-------------------------------------------------------------------
+static inline int32_t gimbal_derivative(struct Gimbal *gimbal, int32_t error, int32_t interval_us)
+{
+	int32_t error_delta = error - gimbal->previous_error;
+	int32_t alpha;
+
+	if (gimbal->derivative_period_us > 0)
+	{
+		if (interval_us >= GIMBAL_MAX_INTERVAL_US)
+			error_delta = 0;
+		else
+			error_delta = (int32_t) (((int64_t) error_delta * gimbal->derivative_period_us) / interval_us);
+	}
+
+	if (gimbal->derivative_filter_us > 0)
+	{
+		// First-order low-pass, alpha = dt / (tau + dt) in Q10
+		alpha = (int32_t) (((int64_t) interval_us << 10) / (gimbal->derivative_filter_us + interval_us));
+		gimbal->filtered_delta += (int32_t) ((((int64_t) error_delta << GIMBAL_DELTA_FRACTION_BITS)
+				- gimbal->filtered_delta) * alpha >> 10);
+		return (gimbal->filtered_delta * gimbal->derivative_gain) >> GIMBAL_DELTA_FRACTION_BITS;
+	}
+	return error_delta * gimbal->derivative_gain;
+}
+
+template <class Axis>
+static inline void gimbal_move(struct Gimbal *gimbal, int32_t velocity)
+{
+	gimbal->position += velocity;
+
+	if (gimbal->position > Axis::MAX_POS)
+	{
+		gimbal->position = Axis::MAX_POS;
+	} else if (gimbal->position < Axis::MIN_POS)
+	{
+		gimbal->position = Axis::MIN_POS;
+	}
+}
+
+static inline void gimbal_finish(struct Gimbal *gimbal, int32_t error, int32_t interval_us)
+{
+	gimbal->previous_error = error;
+}
+
+struct PLaw {
+	template <class Axis>
+	static inline void update(struct Gimbal *gimbal, int32_t error, int32_t interval_us)
+	{
+		gimbal_move<Axis>(gimbal, (error * gimbal->proportional_gain) >> 10);
+		gimbal_finish(gimbal, error, interval_us);
+	}
+};
+
+struct PdLaw {
+	template <class Axis>
+	static inline void update(struct Gimbal *gimbal, int32_t error, int32_t interval_us)
+	{
+		if (gimbal_error_valid(gimbal))
+		{
+			interval_us = gimbal_interval(gimbal, interval_us);
+			/* Using the proportional and derivative gain for the gimbal,
+			   calculate the change to the position.  */
+			gimbal_move<Axis>(gimbal, (error * gimbal->proportional_gain + gimbal_derivative(gimbal, error, interval_us)) >> 10);
+		}
+		else
+			gimbal->filtered_delta = 0;
+		gimbal_finish(gimbal, error, interval_us);
+	}
+};
+
+//-------------------------------------------------------------------
+// PID; ANTI_WINDUP selects the clamped variant
+//-------------------------------------------------------------------
+template <bool ANTI_WINDUP>
+struct PidLawT {
+	template <class Axis>
+	static inline void update(struct Gimbal *gimbal, int32_t error, int32_t interval_us)
+	{
+		int32_t step;
+		int32_t integral;
+		int64_t limit;
+
+		if (!gimbal_error_valid(gimbal))
+		{
+			gimbal->filtered_delta = 0;
+			gimbal_reset_integral(gimbal);
+			gimbal_finish(gimbal, error, interval_us);
+			return;
+		}
+
+		interval_us = gimbal_interval(gimbal, interval_us);
+		step = (int32_t) (((int64_t) error * gimbal_integral_interval(gimbal, interval_us) << GIMBAL_INTEGRAL_FRACTION_BITS)
+				/ GIMBAL_DEFAULT_INTERVAL_US);
+		integral = gimbal->integral + step;
+		if (ANTI_WINDUP)
+		{
+			// Against the stop the integral would only grow; the I term
+			// alone never needs more than the whole travel
+			if (((gimbal->position >= Axis::MAX_POS) && gimbal_step_drives(step, gimbal->integral_gain, 1))
+					|| ((gimbal->position <= Axis::MIN_POS) && gimbal_step_drives(step, gimbal->integral_gain, -1)))
+				integral = gimbal->integral;
+			limit = ((int64_t) (Axis::MAX_POS - Axis::MIN_POS) << (10 + GIMBAL_INTEGRAL_FRACTION_BITS));
+			if ((gimbal->integral_gain != 0) && ((int64_t) integral * gimbal->integral_gain > limit))
+				integral = (int32_t) (limit / gimbal->integral_gain);
+			else if ((gimbal->integral_gain != 0) && ((int64_t) integral * gimbal->integral_gain < -limit))
+				integral = (int32_t) (-limit / gimbal->integral_gain);
+		}
+		else if (integral > GIMBAL_INTEGRAL_GUARD)
+			integral = GIMBAL_INTEGRAL_GUARD;
+		else if (integral < -GIMBAL_INTEGRAL_GUARD)
+			integral = -GIMBAL_INTEGRAL_GUARD;
+		gimbal->integral = integral;
+
+		gimbal_move<Axis>(gimbal, (int32_t) ((error * gimbal->proportional_gain + gimbal_derivative(gimbal, error, interval_us)
+				+ (((int64_t) integral * gimbal->integral_gain) >> GIMBAL_INTEGRAL_FRACTION_BITS)) >> 10));
+		gimbal_finish(gimbal, error, interval_us);
+	}
+};
+
+typedef PidLawT<false> PidLaw;
+typedef PidLawT<true>  PidAntiWindupLaw;
+
+//-------------------------------------------------------------------
+// Float versions
+//-------------------------------------------------------------------
+// Clamped positions are at or above MIN_POS, so truncation rounds
+template <class Axis>
+static inline int32_t gimbal_round(float position)
+{
+	return (int32_t) (position - Axis::MIN_POS + 0.5f) + Axis::MIN_POS;
+}
+
+static inline float gimbal_derivative_float(struct Gimbal *gimbal, int32_t error, int32_t interval_us)
+{
+	struct GimbalFloat *state = &gimbal->floating;
+	float error_delta = (float) (error - gimbal->previous_error);
+	float alpha;
+
+	if (gimbal->derivative_period_us > 0)
+	{
+		if (interval_us >= GIMBAL_MAX_INTERVAL_US)
+			error_delta = 0;
+		else
+			error_delta *= (float) gimbal->derivative_period_us / (float) interval_us;
+	}
+
+	if (gimbal->derivative_filter_us > 0)
+	{
+		alpha = (float) interval_us / (float) (gimbal->derivative_filter_us + interval_us);
+		state->filtered_delta += (error_delta - state->filtered_delta) * alpha;
+		return state->filtered_delta;
+	}
+	return error_delta;
+}
+
+template <bool DERIVATIVE, bool INTEGRAL, bool ANTI_WINDUP>
+struct FloatLawT {
+	template <class Axis>
+	static inline void update(struct Gimbal *gimbal, int32_t error, int32_t interval_us)
+	{
+		struct GimbalFloat *state = &gimbal->floating;
+		const float guard = (float) GIMBAL_INTEGRAL_GUARD / (1 << GIMBAL_INTEGRAL_FRACTION_BITS)
+				* GIMBAL_DEFAULT_INTERVAL_US * 1e-6f;
+		const float travel = (float) (Axis::MAX_POS - Axis::MIN_POS);
+		float velocity;
+		float step;
+		float integral;
+
+		if (gimbal_round<Axis>(state->position) != gimbal->position)
+			state->position = (float) gimbal->position;
+
+		if ((DERIVATIVE || INTEGRAL) && !gimbal_error_valid(gimbal))
+		{
+			state->filtered_delta = 0;
+			gimbal_reset_integral(gimbal);
+			gimbal_finish(gimbal, error, interval_us);
+			return;
+		}
+
+		velocity = state->proportional_gain * (float) error;
+		if (DERIVATIVE || INTEGRAL)
+			interval_us = gimbal_interval(gimbal, interval_us);
+		if (DERIVATIVE)
+			velocity += state->derivative_gain * gimbal_derivative_float(gimbal, error, interval_us);
+		if (INTEGRAL)
+		{
+			step = (float) error * (float) gimbal_integral_interval(gimbal, interval_us) * 1e-6f;
+			integral = state->integral + step;
+			if (ANTI_WINDUP)
+			{
+				if (((state->position >= Axis::MAX_POS) && ((step > 0) == (state->integral_gain > 0)) && (step != 0))
+						|| ((state->position <= Axis::MIN_POS) && ((step > 0) != (state->integral_gain > 0)) && (step != 0)))
+					integral = state->integral;
+				if (integral * state->integral_gain > travel)
+					integral = travel / state->integral_gain;
+				else if (integral * state->integral_gain < -travel)
+					integral = -travel / state->integral_gain;
+			}
+			else if (integral > guard)
+				integral = guard;
+			else if (integral < -guard)
+				integral = -guard;
+			state->integral = integral;
+			velocity += state->integral_gain * integral;
+		}
+
+		state->position += velocity;
+		if (state->position > Axis::MAX_POS)
+			state->position = Axis::MAX_POS;
+		else if (state->position < Axis::MIN_POS)
+			state->position = Axis::MIN_POS;
+		gimbal->position = gimbal_round<Axis>(state->position);
+		gimbal_finish(gimbal, error, interval_us);
+	}
+};
+
+typedef FloatLawT<false, false, false> FloatPLaw;
+typedef FloatLawT<true,  false, false> FloatPdLaw;
+typedef FloatLawT<true,  true,  false> FloatPidLaw;
+typedef FloatLawT<true,  true,  true>  FloatPidAntiWindupLaw;
+
+//-------------------------------------------------------------------
+// The law chosen at startup; one well-predicted branch per update
+//-------------------------------------------------------------------
+struct SelectedLaw {
+	template <class Axis>
+	static inline void update(struct Gimbal *gimbal, int32_t error, int32_t interval_us)
+	{
+		switch (gimbal->law)
+		{
+		case GIMBAL_LAW_P:              PLaw::update<Axis>(gimbal, error, interval_us); break;
+		case GIMBAL_LAW_PID:            PidLaw::update<Axis>(gimbal, error, interval_us); break;
+		case GIMBAL_LAW_PID_ANTI_WINDUP: PidAntiWindupLaw::update<Axis>(gimbal, error, interval_us); break;
+		case GIMBAL_LAW_P_FLOAT:        FloatPLaw::update<Axis>(gimbal, error, interval_us); break;
+		case GIMBAL_LAW_PD_FLOAT:       FloatPdLaw::update<Axis>(gimbal, error, interval_us); break;
+		case GIMBAL_LAW_PID_FLOAT:      FloatPidLaw::update<Axis>(gimbal, error, interval_us); break;
+		case GIMBAL_LAW_PID_ANTI_WINDUP_FLOAT: FloatPidAntiWindupLaw::update<Axis>(gimbal, error, interval_us); break;
+		default:                        PdLaw::update<Axis>(gimbal, error, interval_us); break;
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,539 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include "ShapeType.h"
+#include "ShapeTypeSupport.h"
+#include "ServoControl.h"
+#include "ServoControlSupport.h"
+#include "tracker_metrics.h"
+#include "tracker_time.h"
+#include "qos_bench.h"
+
+#include "ndds/ndds_cpp.h"
+
+#define BENCH_OFFSET_PIXELS 20
+
+struct TrackerThread {
+	int domain_id;
+	struct TrackerConfig config;
+	pthread_t thread;
+	int result;
+};
+
+struct BenchSession {
+	struct TrackerThread tracker;
+	bool started;
+	DDSDomainParticipant *participant;
+	ShapeTypeExtendedDataWriter *circle_writer;
+	ServoControlDataReader *servo_reader;
+	ShapeTypeExtended shape;
+	char color[128 + 1];
+};
+
+struct QosBenchResult {
+	int      exchanges;
+	int      lost;
+	uint64_t max_us;
+	uint64_t histogram[METRICS_LATENCY_BUCKETS];
+	int64_t  cpu_us;        // process CPU outside the tracker thread: bench, DDS threads
+	int64_t  tracker_cpu_us; // the tracker thread, busy-polling included
+	uint64_t flood_written;
+	uint64_t flood_received;
+};
+
+struct SweepStep {
+	int      rate_hz;
+	uint64_t written;
+	uint64_t matched;
+	int64_t  elapsed_us;       // first write to last
+	uint64_t max_us;
+	uint64_t histogram[METRICS_LATENCY_BUCKETS];
+};
+
+static void *tracker_thread_main(void *arg)
+{
+	struct TrackerThread *tracker = (struct TrackerThread *) arg;
+
+	tracker->result = track(tracker->domain_id, &tracker->config);
+	return NULL;
+}
+
+static int64_t thread_cpu_us(pthread_t thread)
+{
+	clockid_t clock;
+	struct timespec ts;
+
+	if ((pthread_getcpuclockid(thread, &clock) != 0) || (clock_gettime(clock, &ts) != 0))
+		return 0;
+	return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+//-------------------------------------------------------------------
+// Both directions must be matched before timing starts: our Circle
+// writer with the tracker's reader and the tracker's servo writer
+// with our reader
+//-------------------------------------------------------------------
+static bool wait_for_match(DDSDataWriter *writer, DDSDataReader *reader)
+{
+	DDS_PublicationMatchedStatus publication;
+	DDS_SubscriptionMatchedStatus subscription;
+
+	for (int waited = 0; waited < QOS_BENCH_MATCH_MS; waited += 10)
+	{
+		writer->get_publication_matched_status(publication);
+		reader->get_subscription_matched_status(subscription);
+		if ((publication.current_count > 0) && (subscription.current_count > 0))
+			return true;
+		usleep(10000);
+	}
+	return false;
+}
+
+static int run_exchanges(ShapeTypeExtendedDataWriter *circle_writer, ServoControlDataReader *servo_reader,
+		DDSWaitSet *waitset, ShapeTypeExtended *shape, pthread_t tracker_thread, struct QosBenchResult *result)
+{
+	const DDS_Duration_t timeout = { 0, QOS_BENCH_TIMEOUT_MS * 1000000 };
+	DDSConditionSeq active;
+	ServoControl command;
+	DDS_SampleInfo info;
+	int64_t cpu_start = 0;
+	int64_t tracker_cpu_start = 0;
+	int64_t start_us;
+	uint64_t latency_us;
+	bool answered;
+
+	memset(result, 0, sizeof(*result));
+	ServoControl_initialize(&command);
+
+	for (int i = 0; i < QOS_BENCH_WARMUP + QOS_BENCH_EXCHANGES; i++)
+	{
+		// Drop anything left over from a late answer
+		while (servo_reader->take_next_sample(command, info) == DDS_RETCODE_OK) {}
+
+		if (i == QOS_BENCH_WARMUP)
+		{
+			cpu_start = time_process_cpu_us();
+			tracker_cpu_start = thread_cpu_us(tracker_thread);
+		}
+
+		// Alternate either side of center so every frame moves the servo
+		shape->x = PIXY_X_CENTER + (((i & 1) != 0) ? BENCH_OFFSET_PIXELS : -BENCH_OFFSET_PIXELS);
+		shape->y = PIXY_Y_CENTER;
+		start_us = time_monotonic_us();
+		if (circle_writer->write(*shape, DDS_HANDLE_NIL) != DDS_RETCODE_OK)
+		{
+			fprintf(stderr, "qos bench: Circle write error\n");
+			return -1;
+		}
+
+		answered = false;
+		while (!answered && (waitset->wait(active, timeout) == DDS_RETCODE_OK))
+			answered = (servo_reader->take_next_sample(command, info) == DDS_RETCODE_OK) && info.valid_data;
+		latency_us = (uint64_t) (time_monotonic_us() - start_us);
+
+		if (i < QOS_BENCH_WARMUP) continue;
+		result->exchanges++;
+		if (!answered)
+		{
+			result->lost++;
+			continue;
+		}
+		result->histogram[metrics_latency_bucket(latency_us)]++;
+		if (latency_us > result->max_us) result->max_us = latency_us;
+	}
+
+	result->tracker_cpu_us = thread_cpu_us(tracker_thread) - tracker_cpu_start;
+	result->cpu_us = (time_process_cpu_us() - cpu_start) - result->tracker_cpu_us;
+	return 0;
+}
+
+//-------------------------------------------------------------------
+// Write Circles as fast as the writer takes them and count the
+// commands that come back
+//-------------------------------------------------------------------
+static void run_flood(ShapeTypeExtendedDataWriter *circle_writer, ServoControlDataReader *servo_reader,
+		ShapeTypeExtended *shape, struct QosBenchResult *result)
+{
+	ServoControl command;
+	DDS_SampleInfo info;
+	int64_t end_us = time_monotonic_us() + QOS_BENCH_FLOOD_MS * 1000;
+
+	ServoControl_initialize(&command);
+	while (time_monotonic_us() < end_us)
+	{
+		shape->x = PIXY_X_CENTER + (((result->flood_written & 1) != 0) ? BENCH_OFFSET_PIXELS : -BENCH_OFFSET_PIXELS);
+		if (circle_writer->write(*shape, DDS_HANDLE_NIL) == DDS_RETCODE_OK)
+			result->flood_written++;
+		while (servo_reader->take_next_sample(command, info) == DDS_RETCODE_OK)
+			if (info.valid_data) result->flood_received++;
+	}
+
+	end_us = time_monotonic_us() + QOS_BENCH_DRAIN_MS * 1000;
+	while (time_monotonic_us() < end_us)
+	{
+		while (servo_reader->take_next_sample(command, info) == DDS_RETCODE_OK)
+			if (info.valid_data) result->flood_received++;
+		usleep(1000);
+	}
+}
+
+//-------------------------------------------------------------------
+// A tracker thread plus the bench's own participant playing the Pixy
+// bridge (Circle writer) and the servo node (ServoControl reader).
+// session_close() must follow session_open() even when it failed.
+//-------------------------------------------------------------------
+static int session_open(struct BenchSession *session, int domain_id, const struct TrackerConfig *base,
+		const char *profile, enum TrackerTransport transport)
+{
+	DDSPublisher *publisher = NULL;
+	DDSTopic *shape_topic = NULL;
+	DDSTopic *servo_topic = NULL;
+
+	// Plain closed loop: one stamped command per Circle, nothing else on the wire
+	session->participant = NULL;
+	session->circle_writer = NULL;
+	session->servo_reader = NULL;
+	session->tracker.domain_id = domain_id;
+	session->tracker.config = *base;
+	session->tracker.config.qos_profile = profile;
+	session->tracker.config.transport = transport;
+	session->tracker.config.status_period_ms = 0;
+	session->tracker.config.trajectory_mode = TRAJECTORY_OFF;
+	session->tracker.config.search_kind = SEARCH_NONE;
+	session->tracker.config.calibrate_path = NULL;
+	session->tracker.config.record_path = NULL;
+	session->tracker.config.alloc_check = false;
+	session->tracker.config.profile = false;
+	session->tracker.config.stamp_commands = true;
+	session->tracker.config.roi_margin = 0;
+	session->tracker.config.dead_band = 0;
+	session->tracker.result = 0;
+	tracker_set_running(true);
+	session->started = (pthread_create(&session->tracker.thread, NULL, tracker_thread_main, &session->tracker) == 0);
+	if (!session->started)
+	{
+		fprintf(stderr, "qos bench: tracker thread create error\n");
+		return -1;
+	}
+
+	session->participant = transport_create_participant(domain_id, TRACKER_QOS_LIBRARY, profile, transport);
+	if (session->participant == NULL)
+	{
+		fprintf(stderr, "qos bench: create participant error (%s)\n", profile);
+		return -1;
+	}
+	ShapeTypeExtendedTypeSupport::register_type(session->participant, ShapeTypeExtendedTypeSupport::get_type_name());
+	ServoControlTypeSupport::register_type(session->participant, ServoControlTypeSupport::get_type_name());
+	shape_topic = session->participant->create_topic("Circle", ShapeTypeExtendedTypeSupport::get_type_name(),
+			DDS_TOPIC_QOS_DEFAULT, NULL, DDS_STATUS_MASK_NONE);
+	servo_topic = session->participant->create_topic(DEFAULT_CAM_CONTROL_TOPIC_NAME, ServoControlTypeSupport::get_type_name(),
+			DDS_TOPIC_QOS_DEFAULT, NULL, DDS_STATUS_MASK_NONE);
+	publisher  = session->participant->create_publisher(DDS_PUBLISHER_QOS_DEFAULT, NULL, DDS_STATUS_MASK_NONE);
+	if ((shape_topic == NULL) || (servo_topic == NULL) || (publisher == NULL))
+	{
+		fprintf(stderr, "qos bench: topic/publisher error\n");
+		return -1;
+	}
+	session->circle_writer = ShapeTypeExtendedDataWriter::narrow(
+			publisher->create_datawriter_with_profile(shape_topic, TRACKER_QOS_LIBRARY, profile, NULL, DDS_STATUS_MASK_NONE));
+	session->servo_reader = ServoControlDataReader::narrow(transport_create_datareader(session->participant, servo_topic,
+			TRACKER_QOS_LIBRARY, profile, transport, NULL, DDS_STATUS_MASK_NONE));
+	if ((session->circle_writer == NULL) || (session->servo_reader == NULL))
+	{
+		fprintf(stderr, "qos bench: writer/reader error\n");
+		return -1;
+	}
+
+	if (!wait_for_match(session->circle_writer, session->servo_reader))
+	{
+		fprintf(stderr, "qos bench: %s did not match within %d ms\n", profile, QOS_BENCH_MATCH_MS);
+		return -1;
+	}
+
+	session->shape.color = session->color;
+	ShapeTypeExtended_initialize_ex(&session->shape, RTI_TRUE, RTI_FALSE);
+	snprintf(session->color, sizeof(session->color), "%s", sigName[base->tracked_channel]);
+	session->shape.shapesize = 30;
+
+	return 0;
+}
+
+// Returns -1 if the tracker itself failed
+static int session_close(struct BenchSession *session)
+{
+	tracker_set_running(false);
+	if (session->started)
+		pthread_join(session->tracker.thread, NULL);
+	if (session->participant != NULL)
+	{
+		session->participant->delete_contained_entities();
+		DDSTheParticipantFactory->delete_participant(session->participant);
+	}
+
+	return (session->started && (session->tracker.result == 0)) ? 0 : -1;
+}
+
+static int bench_profile(int domain_id, const struct TrackerConfig *base, const char *profile,
+		enum TrackerTransport transport, struct QosBenchResult *result)
+{
+	struct BenchSession session;
+	DDSStatusCondition *condition = NULL;
+	DDSWaitSet waitset;
+	int status = -1;
+
+	if (session_open(&session, domain_id, base, profile, transport) == 0)
+	{
+		condition = session.servo_reader->get_statuscondition();
+		condition->set_enabled_statuses(DDS_DATA_AVAILABLE_STATUS);
+		waitset.attach_condition(condition);
+		status = run_exchanges(session.circle_writer, session.servo_reader, &waitset, &session.shape,
+				session.tracker.thread, result);
+		waitset.detach_condition(condition);
+		if (status == 0)
+			run_flood(session.circle_writer, session.servo_reader, &session.shape, result);
+	}
+	if (session_close(&session) != 0) status = -1;
+
+	return status;
+}
+
+static void print_result(const char *transport, const char *name, const struct QosBenchResult *result)
+{
+	printf("%-6s %-12s %7d %5d %7llu %7llu %7llu %7llu %9.1f %9.1f %8llu %8llu\n", transport, name, result->exchanges, result->lost,
+			(unsigned long long) metrics_latency_quantile(result->histogram, 0.50),
+			(unsigned long long) metrics_latency_quantile(result->histogram, 0.90),
+			(unsigned long long) metrics_latency_quantile(result->histogram, 0.99),
+			(unsigned long long) result->max_us,
+			(result->exchanges > 0) ? (double) result->cpu_us / result->exchanges : 0.0,
+			(result->exchanges > 0) ? (double) result->tracker_cpu_us / result->exchanges : 0.0,
+			(unsigned long long) (result->flood_written * 1000 / QOS_BENCH_FLOOD_MS),
+			(unsigned long long) (result->flood_received * 1000 / QOS_BENCH_FLOOD_MS));
+	if (result->lost == result->exchanges)
+		printf("%-19s no commands came back - check the profile matches the tracker's\n", "");
+}
+
+static int bench_profiles(int domain_id, const struct TrackerConfig *config, const char *profiles, enum TrackerTransport transport)
+{
+	struct QosBenchResult result;
+	char list[256];
+	char *saveptr = NULL;
+	char *name;
+	int status = 0;
+
+	if (strcmp(profiles, "all") == 0)
+	{
+		for (int p = 0; p < trackerQosProfileCount; p++)
+		{
+			if (bench_profile(domain_id, config, trackerQosProfiles[p].profile, transport, &result) != 0)
+			{
+				status = -1;
+				continue;
+			}
+			print_result(transport_name(transport), trackerQosProfiles[p].name, &result);
+		}
+		return status;
+	}
+
+	snprintf(list, sizeof(list), "%s", profiles);
+	for (name = strtok_r(list, ",", &saveptr); name != NULL; name = strtok_r(NULL, ",", &saveptr))
+	{
+		if (bench_profile(domain_id, config, tracker_qos_profile(name), transport, &result) != 0)
+		{
+			status = -1;
+			continue;
+		}
+		print_result(transport_name(transport), name, &result);
+	}
+
+	return status;
+}
+
+int qos_bench_run(int domain_id, const struct TrackerConfig *config, const char *profiles, const char *transports)
+{
+	char list[64];
+	char *saveptr = NULL;
+	char *name;
+	int transport;
+	int status = 0;
+
+	printf("QoS bench on domain %d: %d exchanges per run, latency Circle write -> ServoControl received;\n"
+			"flood writes Circles back to back for %d ms (in/s written, out/s commands received);\n"
+			"cpu is the rest of the process, trk the tracker thread including its busy-poll\n",
+			domain_id, QOS_BENCH_EXCHANGES, QOS_BENCH_FLOOD_MS);
+	printf("%-6s %-12s %7s %5s %7s %7s %7s %7s %9s %9s %8s %8s\n", "trans", "profile", "samples", "lost",
+			"p50 us", "p90 us", "p99 us", "max us", "cpu us/ex", "trk us/ex", "in/s", "out/s");
+
+	snprintf(list, sizeof(list), "%s", transports);
+	for (name = strtok_r(list, ",", &saveptr); name != NULL; name = strtok_r(NULL, ",", &saveptr))
+	{
+		transport = transport_parse(name);
+		if (transport < 0)
+		{
+			fprintf(stderr, "unknown transport %s\n", name);
+			status = -1;
+			continue;
+		}
+		if (bench_profiles(domain_id, config, profiles, (enum TrackerTransport) transport) != 0)
+			status = -1;
+	}
+
+	return status;
+}
+
+//-------------------------------------------------------------------
+// sent[] is strictly increasing, so a command's source timestamp is
+// looked up by bisection
+//-------------------------------------------------------------------
+static bool stamp_sent(const int64_t *sent, uint64_t count, int64_t stamp_us)
+{
+	uint64_t low = 0;
+	uint64_t high = count;
+
+	while (low < high)
+	{
+		uint64_t mid = low + (high - low) / 2;
+
+		if (sent[mid] < stamp_us)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return (low < count) && (sent[low] == stamp_us);
+}
+
+static void collect_commands(ServoControlDataReader *servo_reader, ServoControl &command,
+		const int64_t *sent, struct SweepStep *step)
+{
+	DDS_SampleInfo info;
+	int64_t stamp_us;
+	int64_t latency_us;
+
+	while (servo_reader->take_next_sample(command, info) == DDS_RETCODE_OK)
+	{
+		if (!info.valid_data) continue;
+		stamp_us = DDS_TIME_TO_US(info.source_timestamp);
+		if (!stamp_sent(sent, step->written, stamp_us)) continue;
+
+		latency_us = time_realtime_us() - stamp_us;
+		if (latency_us < 0) latency_us = 0;
+		step->matched++;
+		step->histogram[metrics_latency_bucket((uint64_t) latency_us)]++;
+		if ((uint64_t) latency_us > step->max_us) step->max_us = (uint64_t) latency_us;
+	}
+}
+
+//-------------------------------------------------------------------
+// Open loop at a fixed rate: Circles go out on schedule whether or
+// not commands come back.  Each carries a unique source timestamp,
+// which the stamped tracker copies to the command it causes.
+//-------------------------------------------------------------------
+static int run_rate(struct BenchSession *session, int rate_hz, struct SweepStep *step)
+{
+	uint64_t planned = (uint64_t) rate_hz * QOS_SWEEP_STEP_MS / 1000;
+	int64_t *sent;
+	int64_t start_us;
+	int64_t end_us;
+	int64_t stamp_us;
+	int64_t last_stamp_us = 0;
+	DDS_Time_t stamp;
+	ServoControl command;
+
+	memset(step, 0, sizeof(*step));
+	step->rate_hz = rate_hz;
+	sent = (int64_t *) malloc(planned * sizeof(*sent));
+	if (sent == NULL)
+	{
+		fprintf(stderr, "latency sweep: no memory for %llu stamps\n", (unsigned long long) planned);
+		return -1;
+	}
+	ServoControl_initialize(&command);
+
+	start_us = time_monotonic_us();
+	for (uint64_t i = 0; i < planned; )
+	{
+		if (time_monotonic_us() < start_us + (int64_t) (i * 1000000 / rate_hz))
+		{
+			collect_commands(session->servo_reader, command, sent, step);
+			continue;
+		}
+
+		stamp_us = time_realtime_us();
+		if (stamp_us <= last_stamp_us) stamp_us = last_stamp_us + 1;
+		last_stamp_us = stamp_us;
+		stamp.sec = (DDS_Long) (stamp_us / 1000000);
+		stamp.nanosec = (DDS_UnsignedLong) (stamp_us % 1000000) * 1000;
+
+		session->shape.x = PIXY_X_CENTER + (((i & 1) != 0) ? BENCH_OFFSET_PIXELS : -BENCH_OFFSET_PIXELS);
+		session->shape.y = PIXY_Y_CENTER;
+		if (session->circle_writer->write_w_timestamp(session->shape, DDS_HANDLE_NIL, stamp) == DDS_RETCODE_OK)
+			sent[step->written++] = stamp_us;
+		i++;
+	}
+	step->elapsed_us = time_monotonic_us() - start_us;
+
+	end_us = time_monotonic_us() + QOS_BENCH_DRAIN_MS * 1000;
+	while (time_monotonic_us() < end_us)
+		collect_commands(session->servo_reader, command, sent, step);
+
+	free(sent);
+	return 0;
+}
+
+// The writer fell behind the schedule or the tracker dropped observations
+static bool step_saturated(const struct SweepStep *step)
+{
+	uint64_t achieved_hz = (step->elapsed_us > 0) ? step->written * 1000000 / step->elapsed_us : 0;
+
+	return (achieved_hz * 100 < (uint64_t) step->rate_hz * QOS_SWEEP_SATURATION_PCT)
+			|| (step->matched * 100 < step->written * QOS_SWEEP_SATURATION_PCT);
+}
+
+static void print_step(const struct SweepStep *step)
+{
+	double seconds = (step->elapsed_us > 0) ? (double) step->elapsed_us / 1000000.0 : 1.0;
+
+	printf("%8d %9.0f %9.0f %6.1f %7llu %7llu %7llu %7llu\n", step->rate_hz,
+			(double) step->written / seconds, (double) step->matched / seconds,
+			(step->written > 0) ? 100.0 * (double) (step->written - step->matched) / (double) step->written : 0.0,
+			(unsigned long long) metrics_latency_quantile(step->histogram, 0.50),
+			(unsigned long long) metrics_latency_quantile(step->histogram, 0.90),
+			(unsigned long long) metrics_latency_quantile(step->histogram, 0.99),
+			(unsigned long long) step->max_us);
+}
+
+int qos_bench_sweep(int domain_id, const struct TrackerConfig *config, int max_hz)
+{
+	struct BenchSession session;
+	struct SweepStep step;
+	int status = -1;
+
+	printf("Latency sweep on domain %d, %s over %s: %d ms per rate, Circle source timestamp -> ServoControl received\n",
+			domain_id, config->qos_profile, transport_name(config->transport), QOS_SWEEP_STEP_MS);
+	printf("%8s %9s %9s %6s %7s %7s %7s %7s\n", "rate/s", "in/s", "out/s", "lost%",
+			"p50 us", "p90 us", "p99 us", "max us");
+
+	if (session_open(&session, domain_id, config, config->qos_profile, config->transport) == 0)
+	{
+		status = 0;
+		for (int rate_hz = QOS_SWEEP_START_HZ; rate_hz <= max_hz; rate_hz *= 2)
+		{
+			if (run_rate(&session, rate_hz, &step) != 0)
+			{
+				status = -1;
+				break;
+			}
+			print_step(&step);
+			if (step_saturated(&step))
+			{
+				printf("Saturated at %d/s\n", rate_hz);
+				break;
+			}
+		}
+	}
+	if (session_close(&session) != 0) status = -1;
+
+	return status;
+}
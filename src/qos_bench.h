@@ -0,0 +1,40 @@
+//-------------------------------------------------------------------
+// qos_bench.h - end-to-end latency and CPU per QoS profile
+//
+// Runs the real tracker loop on a thread and plays the Pixy bridge and
+// the servo node against it in the same process: write one Circle,
+// wait for the ServoControl it causes, repeat.  A flood phase then
+// writes Circles back to back to measure throughput.  Each profile and
+// transport gets a fresh tracker and bench participant.
+//
+// The latency sweep drives the same setup open loop: Circles at a
+// fixed rate, doubling each step until the tracker saturates.  The
+// tracker runs with stamped commands, so every ServoControl carries
+// the source timestamp of the Circle behind it and is matched to it.
+//-------------------------------------------------------------------
+#ifndef QOS_BENCH_H
+#define QOS_BENCH_H
+
+#include "tracker.h"
+
+#define QOS_BENCH_WARMUP      100
+#define QOS_BENCH_EXCHANGES   2000
+#define QOS_BENCH_TIMEOUT_MS  100      // a command not back by then counts as lost
+#define QOS_BENCH_MATCH_MS    10000
+#define QOS_BENCH_FLOOD_MS    1000
+#define QOS_BENCH_DRAIN_MS    100      // stragglers still counted after the flood
+
+#define QOS_SWEEP_START_HZ        100
+#define QOS_SWEEP_STEP_MS         1000
+#define QOS_SWEEP_SATURATION_PCT  90   // below this share written or answered, stop
+
+// profiles is a comma-separated list of -qos names, or "all";
+// transports a comma-separated list of -transport names.
+// Returns 0 if every combination ran.
+int qos_bench_run(int domain_id, const struct TrackerConfig *config, const char *profiles, const char *transports);
+
+// Sweeps input rates up to max_hz with the config's profile and
+// transport.  Returns 0 if the sweep ran.
+int qos_bench_sweep(int domain_id, const struct TrackerConfig *config, int max_hz);
+
+#endif
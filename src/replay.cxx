@@ -0,0 +1,853 @@
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "control.h"
+#include "replay.h"
+
+#define OBSERVATION_MAGIC "PXOB0001"
+#define COMMAND_MAGIC     "PXSC0004"
+#define MAGIC_LEN         8
+
+#define SYNTHETIC_FRAME_US     33333
+#define SYNTHETIC_JITTER_US    3000
+#define SYNTHETIC_DROPOUT_ODDS 500      // one frame in this many starts a dropout
+#define SYNTHETIC_TURN_ODDS    200      // one frame in this many changes the ball's velocity
+#define SYNTHETIC_MAX_SPEED    6        // pixels per frame
+
+// Search pass: the ball is tracked, hides past the lost timeout while
+// it keeps moving, then is visible again whenever the camera's view
+// (the Shapes frame around the head position) covers it
+#define SEARCH_TRACKED_US      2000000
+#define SEARCH_HIDDEN_EXTRA_US 1000000  // hidden for the lost timeout plus up to this
+#define SEARCH_GIVE_UP_US      30000000 // after the ball hides
+#define SEARCH_BALL_SPEED      250      // servo units per second, per axis
+#define SEARCH_START_SPREAD    100      // servo units from the head, per axis
+
+// Everything that changes the output for a given stream
+struct CommandHeader {
+	char     magic[MAGIC_LEN];
+	uint64_t count;
+	int32_t  servo_hz;
+	int32_t  coast_timeout_us;
+	int32_t  lost_timeout_us;
+	int32_t  derivative_period_us;
+	int32_t  derivative_filter_us;
+	int32_t  dead_band;
+	int32_t  dead_band_exit;
+	int32_t  law;
+	int32_t  gate_sigmas;
+	int32_t  calibration_sum;
+};
+
+struct CommandStream {
+	uint8_t *data;
+	size_t   len;
+	size_t   size;
+	uint64_t count;
+	int32_t  pan;
+	int32_t  tilt;
+};
+
+struct SyntheticBall {
+	uint32_t seed;
+	int64_t  now_us;
+	int32_t  x;
+	int32_t  y;
+	int32_t  vx;
+	int32_t  vy;
+	int32_t  x_max;
+	int32_t  y_max;
+};
+
+struct ReplaySource {
+	FILE    *fp;
+	uint64_t remaining;             // synthetic only
+	struct SyntheticBall ball;
+};
+
+struct ReplayCore {
+	struct ControlCore control;
+	uint64_t held;                  // observations the dead band kept from writing
+	uint64_t gated;                 // observations the validation gate rejected
+};
+
+//-------------------------------------------------------------------
+// Command encoding: zig-zag varint deltas
+//-------------------------------------------------------------------
+static int put_varint(struct CommandStream *stream, uint32_t value)
+{
+	if (stream->len + 5 > stream->size)
+	{
+		size_t size = (stream->size > 0) ? stream->size * 2 : 1 << 20;
+		uint8_t *data = (uint8_t *) realloc(stream->data, size);
+
+		if (data == NULL) return -1;
+		stream->data = data;
+		stream->size = size;
+	}
+	while (value >= 0x80)
+	{
+		stream->data[stream->len++] = (uint8_t) (value | 0x80);
+		value >>= 7;
+	}
+	stream->data[stream->len++] = (uint8_t) value;
+
+	return 0;
+}
+
+static int emit_command(struct CommandStream *stream, int32_t pan, int32_t tilt)
+{
+	int32_t dpan = pan - stream->pan;
+	int32_t dtilt = tilt - stream->tilt;
+
+	stream->pan = pan;
+	stream->tilt = tilt;
+	stream->count++;
+
+	if (put_varint(stream, ((uint32_t) dpan << 1) ^ (uint32_t) (dpan >> 31)) != 0) return -1;
+	return put_varint(stream, ((uint32_t) dtilt << 1) ^ (uint32_t) (dtilt >> 31));
+}
+
+static const uint8_t *get_delta(const uint8_t *p, const uint8_t *end, int32_t *delta)
+{
+	uint32_t value = 0;
+	int shift = 0;
+
+	while ((p < end) && (*p & 0x80) && (shift < 28))
+	{
+		value |= (uint32_t) (*p++ & 0x7f) << shift;
+		shift += 7;
+	}
+	if (p >= end) return NULL;
+	value |= (uint32_t) *p++ << shift;
+	*delta = (int32_t) (value >> 1) ^ -(int32_t) (value & 1);
+
+	return p;
+}
+
+static bool next_command(const uint8_t **p, const uint8_t *end, int32_t position[2])
+{
+	int32_t delta;
+
+	for (int axis = 0; axis < 2; axis++)
+	{
+		*p = get_delta(*p, end, &delta);
+		if (*p == NULL)
+		{
+			*p = end;
+			return false;
+		}
+		position[axis] += delta;
+	}
+	return true;
+}
+
+//-------------------------------------------------------------------
+// Observation sources
+//-------------------------------------------------------------------
+static uint32_t synthetic_random(uint32_t *state)
+{
+	*state = *state * 1664525u + 1013904223u;
+	return *state >> 8;
+}
+
+static int32_t synthetic_speed(uint32_t *seed)
+{
+	return (int32_t) (synthetic_random(seed) % (2 * SYNTHETIC_MAX_SPEED + 1)) - SYNTHETIC_MAX_SPEED;
+}
+
+static void synthetic_next(struct SyntheticBall *ball, struct ReplayObservation *obs)
+{
+	ball->now_us += SYNTHETIC_FRAME_US - SYNTHETIC_JITTER_US + synthetic_random(&ball->seed) % (2 * SYNTHETIC_JITTER_US + 1);
+	if ((synthetic_random(&ball->seed) % SYNTHETIC_DROPOUT_ODDS) == 0)
+		ball->now_us += 100000 + synthetic_random(&ball->seed) % 1900000;
+	if ((synthetic_random(&ball->seed) % SYNTHETIC_TURN_ODDS) == 0)
+	{
+		ball->vx = synthetic_speed(&ball->seed);
+		ball->vy = synthetic_speed(&ball->seed);
+	}
+
+	ball->x += ball->vx;
+	ball->y += ball->vy;
+	if ((ball->x < 0) || (ball->x > ball->x_max))
+	{
+		ball->vx = -ball->vx;
+		ball->x = (ball->x < 0) ? -ball->x : 2 * ball->x_max - ball->x;
+	}
+	if ((ball->y < 0) || (ball->y > ball->y_max))
+	{
+		ball->vy = -ball->vy;
+		ball->y = (ball->y < 0) ? -ball->y : 2 * ball->y_max - ball->y;
+	}
+
+	obs->source_us = ball->now_us;
+	obs->x = ball->x + (int32_t) (synthetic_random(&ball->seed) % 3) - 1;
+	obs->y = ball->y + (int32_t) (synthetic_random(&ball->seed) % 3) - 1;
+}
+
+static int source_open(struct ReplaySource *source, const char *name, const struct ReplaySettings *settings)
+{
+	char magic[MAGIC_LEN];
+	const char *p;
+	char *end;
+
+	memset(source, 0, sizeof(*source));
+	if (strncmp(name, "synthetic", 9) == 0)
+	{
+		source->remaining = REPLAY_SYNTHETIC_COUNT;
+		source->ball.seed = REPLAY_SYNTHETIC_SEED;
+		p = name + 9;
+		if (*p == ':')
+		{
+			source->remaining = strtoull(p + 1, &end, 10);
+			if (*end == ':') source->ball.seed = (uint32_t) strtoul(end + 1, &end, 10);
+			p = end;
+		}
+		if (*p != '\0')
+		{
+			fprintf(stderr, "replay: bad source %s, want synthetic[:count[:seed]]\n", name);
+			return -1;
+		}
+		source->ball.now_us = REPLAY_START_US;
+		source->ball.x_max = 2 * settings->x_center;
+		source->ball.y_max = 2 * settings->y_center;
+		source->ball.x = settings->x_center;
+		source->ball.y = settings->y_center;
+		source->ball.vx = 3;
+		source->ball.vy = 2;
+		return 0;
+	}
+
+	source->fp = fopen(name, "rb");
+	if (source->fp == NULL)
+	{
+		perror(name);
+		return -1;
+	}
+	if ((fread(magic, 1, MAGIC_LEN, source->fp) != MAGIC_LEN) || (memcmp(magic, OBSERVATION_MAGIC, MAGIC_LEN) != 0))
+	{
+		fprintf(stderr, "replay: %s is not an observation recording\n", name);
+		fclose(source->fp);
+		return -1;
+	}
+
+	return 0;
+}
+
+static bool source_next(struct ReplaySource *source, struct ReplayObservation *obs)
+{
+	if (source->fp != NULL)
+		return fread(obs, sizeof(*obs), 1, source->fp) == 1;
+	if (source->remaining == 0)
+		return false;
+	source->remaining--;
+	synthetic_next(&source->ball, obs);
+	return true;
+}
+
+//-------------------------------------------------------------------
+// The tracker's control step (control.h) on the virtual clock, with
+// trajectory shaping and the search scan off.  Between observations
+// the loop would have ticked wherever control_tick() has something
+// to do, so those are the ticks replayed.
+//-------------------------------------------------------------------
+static void core_init(struct ReplayCore *core, const struct ReplaySettings *settings)
+{
+	control_init(&core->control, settings->servo_hz, settings->coast_timeout_us, settings->lost_timeout_us,
+			settings->gate_sigmas);
+	for (int a = 0; a < PanTiltHead::AXES; a++)
+	{
+		core->control.head.axis[a].derivative_period_us = settings->derivative_period_us;
+		core->control.head.axis[a].derivative_filter_us = settings->derivative_filter_us;
+		core->control.head.axis[a].dead_band      = settings->dead_band;
+		core->control.head.axis[a].dead_band_exit = settings->dead_band_exit;
+		core->control.head.axis[a].law            = settings->law;
+	}
+	core->held = 0;
+	core->gated = 0;
+}
+
+static int core_emit(struct ReplayCore *core, struct CommandStream *stream)
+{
+	return emit_command(stream, core->control.head.axis[GIMBAL_PAN].position, core->control.head.axis[GIMBAL_TILT].position);
+}
+
+static int core_tick(struct ReplayCore *core, struct CommandStream *stream, int64_t now_us)
+{
+	if (control_tick(&core->control, now_us) & CONTROL_TICK_WRITE)
+		return core_emit(core, stream);
+	return 0;
+}
+
+// The ticks the loop would act on before until_us
+static int core_tick_until(struct ReplayCore *core, struct CommandStream *stream, int64_t until_us)
+{
+	int64_t tick_us;
+
+	while ((tick_us = control_next_tick_us(&core->control)) < until_us)
+	{
+		if (core_tick(core, stream, tick_us) != 0) return -1;
+	}
+	return 0;
+}
+
+// An observation is taken and the loop ticks in the same pass
+static int core_observe(struct ReplayCore *core, struct CommandStream *stream, const struct ReplayObservation *obs)
+{
+	int64_t now_us = obs->source_us;
+
+	if (core_tick_until(core, stream, now_us) != 0) return -1;
+
+	switch (control_observe(&core->control, obs->x, obs->y, obs->source_us, now_us))
+	{
+	case CONTROL_GATED:
+		core->gated++;
+		break;
+	case CONTROL_HELD:
+		core->held++;
+		break;
+	case CONTROL_WRITE:
+		if (core_emit(core, stream) != 0) return -1;
+		break;
+	}
+	return core_tick(core, stream, now_us);
+}
+
+//-------------------------------------------------------------------
+// Search pass: time from the loss to the first observation, per
+// search pattern, over the same seeded lost-ball trials
+//-------------------------------------------------------------------
+struct SearchBall {
+	int32_t pan;                    // servo units << 10
+	int32_t tilt;
+	int32_t vpan;                   // servo units << 10 per frame
+	int32_t vtilt;
+};
+
+static void search_ball_move(struct SearchBall *ball)
+{
+	const int32_t min_pos = PIXY_RCS_MIN_POS << 10;
+	const int32_t max_pos = PIXY_RCS_MAX_POS << 10;
+
+	ball->pan += ball->vpan;
+	ball->tilt += ball->vtilt;
+	if ((ball->pan < min_pos) || (ball->pan > max_pos))
+	{
+		ball->vpan = -ball->vpan;
+		ball->pan = (ball->pan < min_pos) ? 2 * min_pos - ball->pan : 2 * max_pos - ball->pan;
+	}
+	if ((ball->tilt < min_pos) || (ball->tilt > max_pos))
+	{
+		ball->vtilt = -ball->vtilt;
+		ball->tilt = (ball->tilt < min_pos) ? 2 * min_pos - ball->tilt : 2 * max_pos - ball->tilt;
+	}
+}
+
+// Where the camera would see the ball, inverting the identity
+// calibration; false when it is outside the frame
+static bool search_ball_seen(const struct ControlCore *core, const struct SearchBall *ball,
+		const struct ReplaySettings *settings, struct ReplayObservation *obs)
+{
+	int32_t servo[PanTiltHead::AXES] = { ball->pan >> 10, ball->tilt >> 10 };
+	int32_t error[PanTiltHead::AXES];
+
+	gimbal_head_to_error(&core->head, servo, error);
+	obs->x = settings->x_center - error[GIMBAL_PAN];
+	obs->y = settings->y_center + error[GIMBAL_TILT];
+
+	return (obs->x >= 0) && (obs->x <= 2 * settings->x_center) && (obs->y >= 0) && (obs->y <= 2 * settings->y_center);
+}
+
+static int32_t search_speed(uint32_t *seed)
+{
+	int32_t speed = (int32_t) (synthetic_random(seed) % (2 * SEARCH_BALL_SPEED + 1)) - SEARCH_BALL_SPEED;
+
+	return (int32_t) (((int64_t) speed << 10) * SYNTHETIC_FRAME_US / 1000000);
+}
+
+// One trial; returns the time from the loss to reacquiring, or -1 if
+// the ball was not seen again within SEARCH_GIVE_UP_US of hiding
+static int64_t search_trial(struct ReplayCore *core, const struct ReplaySettings *settings,
+		const struct SearchPattern *pattern, uint32_t *seed)
+{
+	struct ControlCore *control = &core->control;
+	struct SearchBall ball;
+	struct ReplayObservation obs;
+	int64_t now_us = REPLAY_START_US;
+	int64_t hide_us = now_us + SEARCH_TRACKED_US;
+	int64_t show_us = hide_us + settings->lost_timeout_us + synthetic_random(seed) % SEARCH_HIDDEN_EXTRA_US;
+	int64_t lost_us = 0;
+	int64_t tick_us;
+
+	core_init(core, settings);
+	calibration_identity(&control->calibration, settings->x_center, settings->y_center);
+	control->search_pattern = pattern;
+
+	ball.pan  = (PIXY_RCS_CENTER_POS + (int32_t) (synthetic_random(seed) % (2 * SEARCH_START_SPREAD + 1)) - SEARCH_START_SPREAD) << 10;
+	ball.tilt = (PIXY_RCS_CENTER_POS + (int32_t) (synthetic_random(seed) % (2 * SEARCH_START_SPREAD + 1)) - SEARCH_START_SPREAD) << 10;
+	ball.vpan  = search_speed(seed);
+	ball.vtilt = search_speed(seed);
+
+	for (;;)
+	{
+		now_us += SYNTHETIC_FRAME_US;
+		search_ball_move(&ball);
+		while ((tick_us = control_next_tick_us(control)) < now_us)
+		{
+			if ((control_tick(control, tick_us) & CONTROL_TICK_STATE) && (control->state == TARGET_LOST))
+				lost_us = tick_us;
+		}
+		if (now_us - hide_us > SEARCH_GIVE_UP_US)
+			return -1;
+
+		obs.source_us = now_us;
+		if (((now_us < hide_us) || (now_us >= show_us)) && search_ball_seen(control, &ball, settings, &obs))
+			control_observe(control, obs.x, obs.y, obs.source_us, now_us);
+		if ((control_tick(control, now_us) & CONTROL_TICK_STATE) && (control->state == TARGET_TRACKING) && (lost_us != 0))
+			return now_us - lost_us;
+	}
+}
+
+static int compare_times(const void *a, const void *b)
+{
+	int64_t x = *(const int64_t *) a;
+	int64_t y = *(const int64_t *) b;
+
+	return (x > y) - (x < y);
+}
+
+static int replay_search(const struct ReplaySettings *settings, const char *source_name)
+{
+	struct ReplayCore core;
+	struct SearchPattern *pattern;
+	int64_t *times;
+	uint64_t trials = REPLAY_SEARCH_TRIALS;
+	uint32_t seed = REPLAY_SYNTHETIC_SEED;
+	uint32_t trial_seed;
+	uint64_t found;
+	int64_t total_us;
+	const char *p = source_name + 6;
+	char *end;
+	int status = 0;
+
+	if (*p == ':')
+	{
+		trials = strtoull(p + 1, &end, 10);
+		if (*end == ':') seed = (uint32_t) strtoul(end + 1, &end, 10);
+		p = end;
+	}
+	if ((*p != '\0') || (trials == 0))
+	{
+		fprintf(stderr, "replay: bad source %s, want search[:trials[:seed]]\n", source_name);
+		return -1;
+	}
+
+	pattern = (struct SearchPattern *) malloc(sizeof(*pattern));
+	times = (int64_t *) malloc(trials * sizeof(*times));
+	if ((pattern == NULL) || (times == NULL))
+	{
+		fprintf(stderr, "replay: out of memory for %llu search trials\n", (unsigned long long) trials);
+		free(pattern);
+		free(times);
+		return -1;
+	}
+
+	printf("Replay search: %llu trials, ball at up to %d servo units/s hidden %.1f to %.1f s, %s law\n",
+			(unsigned long long) trials, SEARCH_BALL_SPEED, settings->lost_timeout_us / 1e6,
+			(settings->lost_timeout_us + SEARCH_HIDDEN_EXTRA_US) / 1e6, gimbal_law_name(settings->law));
+	printf("  %-8s %6s %10s %10s %10s %10s\n", "pattern", "found", "mean ms", "median ms", "p90 ms", "max ms");
+	for (int kind = SEARCH_NONE; (kind <= SEARCH_HEADING) && (status == 0); kind++)
+	{
+		if (search_pattern_build(pattern, (enum SearchPatternKind) kind, PIXY_RCS_MIN_POS, PIXY_RCS_MAX_POS) != 0)
+		{
+			status = -1;
+			break;
+		}
+
+		// Every pattern gets the same trials
+		trial_seed = seed;
+		found = 0;
+		total_us = 0;
+		for (uint64_t t = 0; t < trials; t++)
+		{
+			int64_t reacquire_us = search_trial(&core, settings, (kind == SEARCH_NONE) ? NULL : pattern, &trial_seed);
+
+			if (reacquire_us >= 0)
+			{
+				times[found++] = reacquire_us;
+				total_us += reacquire_us;
+			}
+		}
+		qsort(times, found, sizeof(*times), compare_times);
+		if (found > 0)
+			printf("  %-8s %6llu %10.0f %10.0f %10.0f %10.0f\n", search_pattern_name((enum SearchPatternKind) kind),
+					(unsigned long long) found, total_us / 1e3 / found, times[found / 2] / 1e3,
+					times[(found * 9) / 10] / 1e3, times[found - 1] / 1e3);
+		else
+			printf("  %-8s %6d %10s %10s %10s %10s\n", search_pattern_name((enum SearchPatternKind) kind), 0, "-", "-", "-", "-");
+	}
+	free(pattern);
+	free(times);
+
+	return status;
+}
+
+//-------------------------------------------------------------------
+// Command files
+//-------------------------------------------------------------------
+static void header_fill(struct CommandHeader *header, const struct ReplaySettings *settings,
+		const struct Calibration *calibration, uint64_t count)
+{
+	memset(header, 0, sizeof(*header));
+	memcpy(header->magic, COMMAND_MAGIC, MAGIC_LEN);
+	header->count = count;
+	header->servo_hz = settings->servo_hz;
+	header->coast_timeout_us = settings->coast_timeout_us;
+	header->lost_timeout_us = settings->lost_timeout_us;
+	header->derivative_period_us = settings->derivative_period_us;
+	header->derivative_filter_us = settings->derivative_filter_us;
+	header->dead_band = settings->dead_band;
+	header->dead_band_exit = settings->dead_band_exit;
+	header->law = settings->law;
+	header->gate_sigmas = settings->gate_sigmas;
+	for (int i = 0; i < CAL_LUT_SIZE; i++)
+		header->calibration_sum += calibration->pan.lut[i] * (i + 1) + calibration->tilt.lut[i] * (i + 1 + CAL_LUT_SIZE);
+}
+
+static int write_commands(const char *path, const struct CommandHeader *header, const struct CommandStream *stream)
+{
+	FILE *fp = fopen(path, "wb");
+
+	if (fp == NULL)
+	{
+		perror(path);
+		return -1;
+	}
+	if ((fwrite(header, sizeof(*header), 1, fp) != 1) || (fwrite(stream->data, 1, stream->len, fp) != stream->len))
+	{
+		fprintf(stderr, "replay: write error on %s\n", path);
+		fclose(fp);
+		return -1;
+	}
+
+	return (fclose(fp) == 0) ? 0 : -1;
+}
+
+static uint8_t *read_file(const char *path, size_t *len)
+{
+	FILE *fp = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long size;
+
+	if (fp == NULL)
+	{
+		perror(path);
+		return NULL;
+	}
+	if ((fseek(fp, 0, SEEK_END) == 0) && ((size = ftell(fp)) >= 0) && (fseek(fp, 0, SEEK_SET) == 0))
+	{
+		data = (uint8_t *) malloc(size > 0 ? size : 1);
+		if ((data != NULL) && (fread(data, 1, size, fp) != (size_t) size))
+		{
+			free(data);
+			data = NULL;
+		}
+		*len = (size_t) size;
+	}
+	fclose(fp);
+	if (data == NULL)
+		fprintf(stderr, "replay: cannot read %s\n", path);
+
+	return data;
+}
+
+//-------------------------------------------------------------------
+// Byte compare first; on a difference decode both streams side by
+// side and report the commands that differ
+//-------------------------------------------------------------------
+static int compare_commands(const char *golden_path, const struct CommandHeader *header, const struct CommandStream *stream)
+{
+	struct CommandHeader golden;
+	const uint8_t *expected;
+	const uint8_t *expected_end;
+	const uint8_t *actual = stream->data;
+	const uint8_t *actual_end = stream->data + stream->len;
+	int32_t expected_pos[2] = { PIXY_RCS_CENTER_POS, PIXY_RCS_CENTER_POS };
+	int32_t actual_pos[2] = { PIXY_RCS_CENTER_POS, PIXY_RCS_CENTER_POS };
+	uint64_t mismatches = 0;
+	uint64_t total;
+	uint8_t *data;
+	size_t len;
+
+	data = read_file(golden_path, &len);
+	if (data == NULL) return -1;
+	if ((len < sizeof(golden)) || (memcmp(data, COMMAND_MAGIC, MAGIC_LEN) != 0))
+	{
+		fprintf(stderr, "replay: %s is not a command file\n", golden_path);
+		free(data);
+		return -1;
+	}
+	memcpy(&golden, data, sizeof(golden));
+	if (memcmp(&golden.servo_hz, &header->servo_hz, sizeof(golden) - offsetof(struct CommandHeader, servo_hz)) != 0)
+	{
+		fprintf(stderr, "replay: %s was recorded with other settings (servo %d Hz, coast %d us, lost %d us, "
+				"d-period %d us, d-filter %d us, dead band %d:%d, law %s, gate %d, calibration %d)\n", golden_path,
+				golden.servo_hz, golden.coast_timeout_us, golden.lost_timeout_us, golden.derivative_period_us,
+				golden.derivative_filter_us, golden.dead_band, golden.dead_band_exit, gimbal_law_name(golden.law),
+				golden.gate_sigmas, golden.calibration_sum);
+		free(data);
+		return -1;
+	}
+
+	expected = data + sizeof(golden);
+	expected_end = data + len;
+	if ((golden.count == header->count) && ((size_t) (expected_end - expected) == stream->len)
+			&& (memcmp(expected, stream->data, stream->len) == 0))
+	{
+		printf("Replay: %llu commands match %s\n", (unsigned long long) header->count, golden_path);
+		free(data);
+		return 0;
+	}
+
+	total = (golden.count > header->count) ? golden.count : header->count;
+	for (uint64_t i = 0; i < total; i++)
+	{
+		bool have_expected = (i < golden.count) && next_command(&expected, expected_end, expected_pos);
+		bool have_actual = (i < header->count) && next_command(&actual, actual_end, actual_pos);
+
+		if (have_expected && have_actual && (expected_pos[0] == actual_pos[0]) && (expected_pos[1] == actual_pos[1]))
+			continue;
+
+		if (mismatches++ < REPLAY_MISMATCH_SHOW)
+		{
+			printf("  command %llu:", (unsigned long long) i);
+			if (have_expected) printf(" golden P: %d T: %d", expected_pos[0], expected_pos[1]);
+			else printf(" golden -");
+			if (have_actual) printf(", replay P: %d T: %d\n", actual_pos[0], actual_pos[1]);
+			else printf(", replay -\n");
+		}
+	}
+	printf("Replay: MISMATCH, %llu of %llu commands differ from %s (%llu golden, %llu replayed)\n",
+			(unsigned long long) mismatches, (unsigned long long) total, golden_path,
+			(unsigned long long) golden.count, (unsigned long long) header->count);
+	free(data);
+
+	return 1;
+}
+
+static int64_t replay_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+//-------------------------------------------------------------------
+// Two laws over the same stream: time per observation, and the
+// commands side by side in servo units
+//-------------------------------------------------------------------
+static void compare_laws(const struct ReplaySettings *settings, const struct CommandStream *stream, int64_t elapsed_ns,
+		const struct CommandStream *other, int64_t other_ns, uint64_t observations)
+{
+	const uint8_t *p = stream->data;
+	const uint8_t *q = other->data;
+	int32_t position[2] = { PIXY_RCS_CENTER_POS, PIXY_RCS_CENTER_POS };
+	int32_t other_position[2] = { PIXY_RCS_CENTER_POS, PIXY_RCS_CENTER_POS };
+	int32_t worst[2] = { 0, 0 };
+	double squares = 0;
+	uint64_t differ = 0;
+	uint64_t count = (stream->count < other->count) ? stream->count : other->count;
+	int32_t diff;
+
+	for (uint64_t i = 0; i < count; i++)
+	{
+		if (!next_command(&p, stream->data + stream->len, position)
+				|| !next_command(&q, other->data + other->len, other_position))
+			break;
+		if ((position[0] != other_position[0]) || (position[1] != other_position[1]))
+			differ++;
+		for (int axis = 0; axis < 2; axis++)
+		{
+			diff = abs(position[axis] - other_position[axis]);
+			if (diff > worst[axis]) worst[axis] = diff;
+			squares += (double) diff * diff;
+		}
+	}
+
+	printf("Replay: %s %.1f ns/observation, %s %.1f ns/observation; %llu of %llu commands differ, "
+			"pan/tilt max %d/%d servo units, rms %.2f\n",
+			gimbal_law_name(settings->law), (observations > 0) ? (double) elapsed_ns / observations : 0.0,
+			gimbal_law_name(settings->compare_law), (observations > 0) ? (double) other_ns / observations : 0.0,
+			(unsigned long long) differ, (unsigned long long) count, worst[0], worst[1],
+			(count > 0) ? sqrt(squares / (2.0 * count)) : 0.0);
+	if (stream->count != other->count)
+		printf("Replay: %s wrote %llu commands, %s %llu\n", gimbal_law_name(settings->law),
+				(unsigned long long) stream->count, gimbal_law_name(settings->compare_law),
+				(unsigned long long) other->count);
+}
+
+//-------------------------------------------------------------------
+// One pass of the core over the whole source
+//-------------------------------------------------------------------
+static int replay_pass(const struct ReplaySettings *settings, const char *source_name, struct ReplayCore *core,
+		struct CommandStream *stream, uint64_t *observations)
+{
+	struct ReplaySource source;
+	struct ReplayObservation obs;
+	int status = 0;
+
+	core_init(core, settings);
+	calibration_identity(&core->control.calibration, settings->x_center, settings->y_center);
+	if ((settings->calibration_path != NULL) && (calibration_load(&core->control.calibration, settings->calibration_path) != 0))
+		return -1;
+	if (source_open(&source, source_name, settings) != 0)
+		return -1;
+
+	memset(stream, 0, sizeof(*stream));
+	stream->pan = stream->tilt = PIXY_RCS_CENTER_POS;
+
+	*observations = 0;
+	while ((status == 0) && source_next(&source, &obs))
+	{
+		status = core_observe(core, stream, &obs);
+		(*observations)++;
+	}
+	// Let the last gap coast out until the target is lost
+	while ((status == 0) && (core->control.target.state != TARGET_LOST))
+		status = core_tick(core, stream, control_next_tick_us(&core->control));
+	if (source.fp != NULL)
+		fclose(source.fp);
+	if (status != 0)
+	{
+		fprintf(stderr, "replay: out of memory after %llu commands\n", (unsigned long long) stream->count);
+		free(stream->data);
+		stream->data = NULL;
+	}
+
+	return status;
+}
+
+int replay_run(const struct ReplaySettings *settings, const char *source_name, const char *out_path, const char *golden_path)
+{
+	struct ReplaySettings baseline_settings;
+	struct ReplaySettings compare_settings;
+	struct ReplayCore core;
+	struct ReplayCore baseline_core;
+	struct CommandStream stream;
+	struct CommandStream baseline;
+	struct CommandStream other;
+	struct CommandHeader header;
+	uint64_t observations;
+	int64_t start_ns;
+	int64_t elapsed_ns;
+	int64_t other_ns;
+	int status = 0;
+
+	if (strncmp(source_name, "search", 6) == 0)
+	{
+		if ((out_path != NULL) || (golden_path != NULL))
+		{
+			fprintf(stderr, "replay: the search pass writes no commands\n");
+			return -1;
+		}
+		return replay_search(settings, source_name);
+	}
+
+	start_ns = replay_now_ns();
+	if (replay_pass(settings, source_name, &core, &stream, &observations) != 0)
+		return -1;
+	elapsed_ns = replay_now_ns() - start_ns;
+
+	printf("Replay %s: %llu observations, %llu commands, %llu bytes, %.1f ns/observation\n", source_name,
+			(unsigned long long) observations, (unsigned long long) stream.count, (unsigned long long) stream.len,
+			(observations > 0) ? (double) elapsed_ns / observations : 0.0);
+
+	if (settings->gate_sigmas > 0)
+		printf("Replay: gate %d sigmas rejected %llu observations\n", settings->gate_sigmas,
+				(unsigned long long) core.gated);
+
+	// What the dead band saves is measured against the same stream
+	// without it; holding also changes the coasting that follows
+	if (settings->dead_band > 0)
+	{
+		baseline_settings = *settings;
+		baseline_settings.dead_band = baseline_settings.dead_band_exit = 0;
+		if (replay_pass(&baseline_settings, source_name, &baseline_core, &baseline, &observations) != 0)
+		{
+			free(stream.data);
+			return -1;
+		}
+		printf("Replay: dead band %d:%d px held %llu observations, %llu commands against %llu without, "
+				"%lld writes saved (%.1f%%)\n", settings->dead_band, settings->dead_band_exit,
+				(unsigned long long) core.held, (unsigned long long) stream.count, (unsigned long long) baseline.count,
+				(long long) baseline.count - (long long) stream.count,
+				(baseline.count > 0) ? 100.0 * ((double) baseline.count - (double) stream.count) / (double) baseline.count : 0.0);
+		free(baseline.data);
+	}
+
+	// The same stream through another law, timed the same way
+	if (settings->compare_law >= 0)
+	{
+		compare_settings = *settings;
+		compare_settings.law = settings->compare_law;
+		start_ns = replay_now_ns();
+		if (replay_pass(&compare_settings, source_name, &baseline_core, &other, &observations) != 0)
+		{
+			free(stream.data);
+			return -1;
+		}
+		other_ns = replay_now_ns() - start_ns;
+		compare_laws(settings, &stream, elapsed_ns, &other, other_ns, observations);
+		free(other.data);
+	}
+
+	header_fill(&header, settings, &core.control.calibration, stream.count);
+	if ((out_path != NULL) && (write_commands(out_path, &header, &stream) != 0))
+		status = -1;
+	if ((status == 0) && (golden_path != NULL))
+		status = compare_commands(golden_path, &header, &stream);
+	free(stream.data);
+
+	return status;
+}
+
+//-------------------------------------------------------------------
+// Recording
+//-------------------------------------------------------------------
+FILE *replay_record_open(const char *path)
+{
+	FILE *fp = fopen(path, "wb");
+
+	if (fp == NULL)
+	{
+		perror(path);
+		return NULL;
+	}
+	if (fwrite(OBSERVATION_MAGIC, 1, MAGIC_LEN, fp) != MAGIC_LEN)
+	{
+		fclose(fp);
+		return NULL;
+	}
+
+	return fp;
+}
+
+void replay_record(FILE *fp, int64_t source_us, int32_t x, int32_t y)
+{
+	struct ReplayObservation obs;
+
+	obs.source_us = source_us;
+	obs.x = x;
+	obs.y = y;
+	fwrite(&obs, sizeof(obs), 1, fp);
+}
+
+void replay_record_close(FILE *fp)
+{
+	if (fp != NULL)
+		fclose(fp);
+}
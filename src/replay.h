@@ -0,0 +1,77 @@
+//-------------------------------------------------------------------
+// replay.h - deterministic controller replay for regression checks
+//
+// Feeds an observation stream through track()'s control step
+// (control.h), on a virtual clock taken from the observations'
+// source timestamps, and produces the ServoControl stream the tracker
+// would write with trajectory shaping off.  Coasting commands are
+// issued at the servo rate in the gaps, as the loop would.  With a
+// dead band, observations that leave both axes holding write nothing,
+// and the run reports how many commands that saved.  With a gate,
+// observations it rejects are dropped as track() drops them.  A
+// second law (e.g. the float version of the first) can be run over
+// the same stream for its cost and its distance from the first law's
+// commands.  Streams are recorded by the tracker (-record)
+// or synthetic: a seeded ball bouncing around the Shapes frame at
+// ~30 Hz with timestamp jitter and occasional dropouts.
+//
+// Command files hold a header with the settings that shape the
+// output, then per command the pan and tilt change from the previous
+// one as zig-zag varints (2 bytes for most commands).  The encoding
+// is canonical, so two runs match exactly when their bytes do and the
+// comparison is a memcmp; only a mismatch is decoded to report it.
+//-------------------------------------------------------------------
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define REPLAY_SYNTHETIC_COUNT 100000     // observations in the checked-in golden run
+#define REPLAY_SYNTHETIC_SEED  1
+#define REPLAY_START_US        1000000000 // virtual clock origin; 0 means "no timestamp"
+#define REPLAY_MISMATCH_SHOW   8
+#define REPLAY_SEARCH_TRIALS   200        // lost-ball trials per search pattern
+
+struct ReplaySettings {
+	int32_t     servo_hz;
+	int32_t     coast_timeout_us;
+	int32_t     lost_timeout_us;
+	int32_t     derivative_period_us;
+	int32_t     derivative_filter_us;
+	int32_t     dead_band;            // pixels, 0 = off
+	int32_t     dead_band_exit;
+	int32_t     law;                  // enum GimbalLaw
+	int32_t     gate_sigmas;          // validation gate, 0 = off
+	int32_t     compare_law;          // also replay with this law and compare; -1 = no
+	int32_t     x_center;
+	int32_t     y_center;
+	const char *calibration_path;     // NULL = identity
+};
+
+// One applied observation, as -record writes it
+struct ReplayObservation {
+	int64_t source_us;
+	int32_t x;
+	int32_t y;
+};
+
+// source is an observation file or "synthetic[:count[:seed]]".  The
+// commands are written to out_path and/or compared with golden_path
+// (either may be NULL).  Returns 0 when the run matched (or there was
+// nothing to compare), 1 on a mismatch, -1 on errors.
+//
+// "search[:trials[:seed]]" is the search pass instead: seeded trials
+// of a ball that is tracked, hides past the lost timeout while it
+// keeps moving, and can be seen again once the camera points at it.
+// Every search pattern (and none) runs the same trials and the time
+// from the loss to the first observation is reported per pattern.
+// Nothing is written or compared.
+int replay_run(const struct ReplaySettings *settings, const char *source, const char *out_path, const char *golden_path);
+
+// Observation recording from the live loop; plain buffered stdio
+FILE *replay_record_open(const char *path);
+void  replay_record(FILE *fp, int64_t source_us, int32_t x, int32_t y);
+void  replay_record_close(FILE *fp);
+
+#endif
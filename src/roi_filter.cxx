@@ -0,0 +1,68 @@
+#include <stdlib.h>
+#include "roi_filter.h"
+
+static const struct RoiWindow openWindow = { ROI_OPEN_MIN, ROI_OPEN_MAX, ROI_OPEN_MIN, ROI_OPEN_MAX };
+
+static int32_t min3(int32_t a, int32_t b, int32_t c)
+{
+	int32_t m = (a < b) ? a : b;
+	return (m < c) ? m : c;
+}
+
+static int32_t max3(int32_t a, int32_t b, int32_t c)
+{
+	int32_t m = (a > b) ? a : b;
+	return (m > c) ? m : c;
+}
+
+static int32_t clamp(int32_t value, int32_t limit)
+{
+	return (value < 0) ? 0 : (value > limit) ? limit : value;
+}
+
+void roi_filter_init(struct RoiFilter *roi, int32_t margin)
+{
+	roi->margin = margin;
+	roi->period_us = 1000000 / ROI_MAX_UPDATE_HZ;
+	roi->next_update_us = 0;
+	roi->window = openWindow;
+	roi->updates = 0;
+}
+
+void roi_filter_window(const struct RoiFilter *roi, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+		int32_t x_center, int32_t y_center, int32_t x_limit, int32_t y_limit, struct RoiWindow *window)
+{
+	window->x_min = clamp(min3(x0, x1, x_center) - roi->margin, x_limit);
+	window->x_max = clamp(max3(x0, x1, x_center) + roi->margin, x_limit);
+	window->y_min = clamp(min3(y0, y1, y_center) - roi->margin, y_limit);
+	window->y_max = clamp(max3(y0, y1, y_center) + roi->margin, y_limit);
+}
+
+//-------------------------------------------------------------------
+// Edges within a quarter margin of the published ones are not worth
+// a parameter change
+//-------------------------------------------------------------------
+static bool window_close(const struct RoiWindow *a, const struct RoiWindow *b, int32_t slack)
+{
+	return (abs(a->x_min - b->x_min) <= slack) && (abs(a->x_max - b->x_max) <= slack)
+			&& (abs(a->y_min - b->y_min) <= slack) && (abs(a->y_max - b->y_max) <= slack);
+}
+
+bool roi_filter_propose(struct RoiFilter *roi, const struct RoiWindow *window, int64_t now_us)
+{
+	if (window == NULL)
+	{
+		if (roi_filter_is_open(roi)) return false;
+		window = &openWindow;
+	}
+	else if (!roi_filter_is_open(roi) && window_close(window, &roi->window, roi->margin / 4))
+		return false;
+	else if (now_us < roi->next_update_us)
+		return false;
+
+	roi->window = *window;
+	roi->next_update_us = now_us + roi->period_us;
+	roi->updates++;
+
+	return true;
+}
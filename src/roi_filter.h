@@ -0,0 +1,62 @@
+//-------------------------------------------------------------------
+// roi_filter.h - moving region of interest for the Circle filter
+//
+// With -roi the tracked-color filter becomes
+//
+//   color MATCH %0 AND x BETWEEN %1 AND %2 AND y BETWEEN %3 AND %4
+//
+// and the window follows the target.  Connext evaluates the filter on
+// the writer when it can, so samples far from the target never reach
+// the network.  The window covers the image position of the target
+// predicted now and one update period ahead, and the image center
+// (where the gimbal is driving it), plus a margin.  It only narrows
+// while TRACKING; coasting or lost opens it to the whole frame so the
+// search can reacquire.
+//
+// Parameter changes are a discovery round trip, so they are bounded:
+// at most ROI_MAX_UPDATE_HZ, and not at all while the proposed window
+// is within a quarter margin of the published one.  Opening is never
+// delayed.  No DDS in here; the tracker owns the topic.
+//-------------------------------------------------------------------
+#ifndef ROI_FILTER_H
+#define ROI_FILTER_H
+
+#include <stdint.h>
+
+#define ROI_MAX_UPDATE_HZ  10
+#define ROI_OPEN_MIN       (-1000000)   // bounds of the "whole frame" window;
+#define ROI_OPEN_MAX       1000000      // wider than any Shapes coordinate
+#define ROI_PARAM_LEN      16           // one formatted parameter, bound or quoted color
+
+struct RoiWindow {
+	int32_t x_min;
+	int32_t x_max;
+	int32_t y_min;
+	int32_t y_max;
+};
+
+struct RoiFilter {
+	int32_t margin;                 // pixels around the predicted span
+	int64_t period_us;              // 1 / ROI_MAX_UPDATE_HZ
+	int64_t next_update_us;
+	struct RoiWindow window;        // last published
+	uint64_t updates;
+};
+
+void roi_filter_init(struct RoiFilter *roi, int32_t margin);
+
+// Window around image positions (x0, y0) and (x1, y1) and the center,
+// clamped to the frame
+void roi_filter_window(const struct RoiFilter *roi, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+		int32_t x_center, int32_t y_center, int32_t x_limit, int32_t y_limit, struct RoiWindow *window);
+
+// Offers the wanted window (NULL = whole frame).  Returns true when
+// it should be published now; the filter then records it as current.
+bool roi_filter_propose(struct RoiFilter *roi, const struct RoiWindow *window, int64_t now_us);
+
+static inline bool roi_filter_is_open(const struct RoiFilter *roi)
+{
+	return roi->window.x_min == ROI_OPEN_MIN;
+}
+
+#endif
@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include "search_pattern.h"
+
+static const char *patternName[] = {
+	"none",
+	"raster",
+	"spiral",
+	"heading"
+};
+
+//-------------------------------------------------------------------
+// Table builders.  The pen remembers where it is so each segment can
+// be split into steps no longer than SEARCH_STEP.
+//-------------------------------------------------------------------
+struct Pen {
+	struct SearchTable *table;
+	int points;       // emitted, including any past the table's end
+	double pan;
+	double tilt;
+};
+
+static void pen_emit(struct Pen *pen, double pan, double tilt)
+{
+	struct SearchTable *table = pen->table;
+
+	if (table->count < SEARCH_MAX_POINTS)
+	{
+		table->point[table->count].pan  = (int16_t) lround(pan);
+		table->point[table->count].tilt = (int16_t) lround(tilt);
+		table->count++;
+	}
+	pen->points++;
+	pen->pan  = pan;
+	pen->tilt = tilt;
+}
+
+static void pen_line_to(struct Pen *pen, double pan, double tilt)
+{
+	double dp = pan - pen->pan;
+	double dt = tilt - pen->tilt;
+	int steps = (int) ceil(sqrt(dp * dp + dt * dt) / SEARCH_STEP);
+	double start_pan = pen->pan;
+	double start_tilt = pen->tilt;
+
+	for (int s = 1; s <= steps; s++)
+		pen_emit(pen, start_pan + dp * s / steps, start_tilt + dt * s / steps);
+}
+
+static int build_raster(struct SearchTable *table, int32_t min_pos, int32_t max_pos)
+{
+	struct Pen pen;
+	bool forward = true;
+	double tilt;
+
+	table->relative = false;
+	pen.table = table;
+	pen.points = 0;
+	pen_emit(&pen, min_pos, min_pos + SEARCH_ROW_SPACING / 2);
+	for (tilt = min_pos + SEARCH_ROW_SPACING / 2; tilt <= max_pos; tilt += SEARCH_ROW_SPACING)
+	{
+		pen_line_to(&pen, pen.pan, tilt);
+		pen_line_to(&pen, forward ? max_pos : min_pos, tilt);
+		forward = !forward;
+	}
+	// Return to the first row so the wrap-around is also smooth
+	pen_line_to(&pen, min_pos, min_pos + SEARCH_ROW_SPACING / 2);
+	return pen.points;
+}
+
+static int build_spiral(struct SearchTable *table)
+{
+	struct Pen pen;
+	double theta = 0.0;
+	double radius = 0.0;
+
+	table->relative = true;
+	pen.table = table;
+	pen.points = 0;
+	pen_emit(&pen, 0.0, 0.0);
+	while (radius < SEARCH_RADIUS)
+	{
+		// Walk the curve finely and emit a point every SEARCH_STEP
+		double pan, tilt;
+
+		theta += 0.002;
+		radius = SEARCH_SPIRAL_PITCH * theta / (2.0 * M_PI);
+		pan  = radius * cos(theta);
+		tilt = radius * sin(theta);
+		if (hypot(pan - pen.pan, tilt - pen.tilt) >= SEARCH_STEP)
+			pen_emit(&pen, pan, tilt);
+	}
+	pen_line_to(&pen, 0.0, 0.0);
+	return pen.points;
+}
+
+static int build_heading(struct SearchTable *table, int octant)
+{
+	struct Pen pen;
+	double angle = octant * M_PI / 4.0;
+	double along_pan = cos(angle);
+	double along_tilt = sin(angle);
+	double side = 1.0;
+
+	table->relative = true;
+	pen.table = table;
+	pen.points = 0;
+	pen_emit(&pen, 0.0, 0.0);
+	// Zig-zag across the heading, widening with distance
+	for (double d = SEARCH_ROW_SPACING / 4; d <= SEARCH_RADIUS; d += SEARCH_ROW_SPACING / 4)
+	{
+		double lateral = side * (SEARCH_ROW_SPACING / 2 + d / 2);
+		pen_line_to(&pen, along_pan * d - along_tilt * lateral, along_tilt * d + along_pan * lateral);
+		side = -side;
+	}
+	pen_line_to(&pen, 0.0, 0.0);
+	return pen.points;
+}
+
+int search_pattern_build(struct SearchPattern *pattern, enum SearchPatternKind kind, int32_t min_pos, int32_t max_pos)
+{
+	int points = 0;
+	int table_points;
+
+	memset(pattern, 0, sizeof(*pattern));
+	pattern->kind = kind;
+	pattern->min_pos = min_pos;
+	pattern->max_pos = max_pos;
+	pattern->table_count = 1;
+
+	switch (kind)
+	{
+	case SEARCH_RASTER:
+		points = build_raster(&pattern->table[0], min_pos, max_pos);
+		break;
+	case SEARCH_SPIRAL:
+		points = build_spiral(&pattern->table[0]);
+		break;
+	case SEARCH_HEADING:
+		pattern->table_count = SEARCH_OCTANTS;
+		for (int octant = 0; octant < SEARCH_OCTANTS; octant++)
+		{
+			table_points = build_heading(&pattern->table[octant], octant);
+			if (table_points > points) points = table_points;
+		}
+		break;
+	default:
+		// SEARCH_NONE: a single point that holds position
+		pattern->table[0].relative = true;
+		pattern->table[0].count = 1;
+		break;
+	}
+
+	// A truncated table would end the scan short of its reach and jump
+	// back to the start
+	if (points > SEARCH_MAX_POINTS)
+	{
+		fprintf(stderr, "search pattern %s needs %d points, tables hold %d (SEARCH_MAX_POINTS)\n",
+				search_pattern_name(kind), points, SEARCH_MAX_POINTS);
+		return -1;
+	}
+	return 0;
+}
+
+void search_begin(struct SearchScan *scan, const struct SearchPattern *pattern,
+		int32_t pan, int32_t tilt, int32_t velocity_pan, int32_t velocity_tilt)
+{
+	int octant = 0;
+
+	if ((pattern->kind == SEARCH_HEADING) && ((velocity_pan != 0) || (velocity_tilt != 0)))
+	{
+		double angle = atan2((double) velocity_tilt, (double) velocity_pan);
+		octant = ((int) lround(angle / (M_PI / 4.0)) + SEARCH_OCTANTS) % SEARCH_OCTANTS;
+	}
+
+	scan->table = &pattern->table[octant];
+	scan->index = 0;
+	scan->center_pan = pan;
+	scan->center_tilt = tilt;
+	scan->min_pos = pattern->min_pos;
+	scan->max_pos = pattern->max_pos;
+}
+
+int search_pattern_parse(const char *name)
+{
+	for (int kind = SEARCH_NONE; kind <= SEARCH_HEADING; kind++)
+	{
+		if (strcmp(name, patternName[kind]) == 0)
+			return kind;
+	}
+	return -1;
+}
+
+const char *search_pattern_name(enum SearchPatternKind kind)
+{
+	return ((unsigned int) kind <= SEARCH_HEADING) ? patternName[kind] : "unknown";
+}
@@ -0,0 +1,96 @@
+//-------------------------------------------------------------------
+// search_pattern.h - precomputed scan tables for a lost target
+//
+// Tables are built once at startup and hold one pan/tilt point per
+// servo tick, so scanning is a table read (plus an add and clamp for
+// the patterns centred on the last known position).
+//
+//   RASTER  - boustrophedon rows over the whole servo range
+//   SPIRAL  - Archimedean spiral out from the last position
+//   HEADING - widening zig-zag along the last direction of travel,
+//             one table per octant
+//-------------------------------------------------------------------
+#ifndef SEARCH_PATTERN_H
+#define SEARCH_PATTERN_H
+
+#include <stdint.h>
+
+#define SEARCH_MAX_POINTS   1024
+#define SEARCH_OCTANTS      8
+#define SEARCH_STEP         8     // servo units per tick
+#define SEARCH_ROW_SPACING  200   // raster rows, about one field of view
+#define SEARCH_SPIRAL_PITCH 160   // radial growth per turn
+#define SEARCH_RADIUS       500   // spiral / heading reach
+
+enum SearchPatternKind {
+	SEARCH_NONE,
+	SEARCH_RASTER,
+	SEARCH_SPIRAL,
+	SEARCH_HEADING
+};
+
+struct SearchPoint {
+	int16_t pan;
+	int16_t tilt;
+};
+
+struct SearchTable {
+	int count;
+	bool relative;    // points are offsets from the scan centre
+	struct SearchPoint point[SEARCH_MAX_POINTS];
+};
+
+struct SearchPattern {
+	enum SearchPatternKind kind;
+	int32_t min_pos;
+	int32_t max_pos;
+	int table_count;  // 1, or SEARCH_OCTANTS for HEADING
+	struct SearchTable table[SEARCH_OCTANTS];
+};
+
+struct SearchScan {
+	const struct SearchTable *table;
+	int index;
+	int32_t center_pan;
+	int32_t center_tilt;
+	int32_t min_pos;
+	int32_t max_pos;
+};
+
+// Fills the tables for kind over min_pos..max_pos on both axes.
+// Returns -1, with a message, if a table would need more than
+// SEARCH_MAX_POINTS points.
+int search_pattern_build(struct SearchPattern *pattern, enum SearchPatternKind kind, int32_t min_pos, int32_t max_pos);
+
+// Starts a scan from the last position; the velocity picks the
+// HEADING octant and is ignored by the other patterns
+void search_begin(struct SearchScan *scan, const struct SearchPattern *pattern,
+		int32_t pan, int32_t tilt, int32_t velocity_pan, int32_t velocity_tilt);
+
+// Next point of the scan, once per servo tick.  Wraps at the end.
+static inline void search_next(struct SearchScan *scan, int32_t *pan, int32_t *tilt)
+{
+	const struct SearchPoint *p = &scan->table->point[scan->index];
+	int32_t next_pan  = p->pan;
+	int32_t next_tilt = p->tilt;
+
+	if (scan->table->relative)
+	{
+		next_pan  += scan->center_pan;
+		next_tilt += scan->center_tilt;
+		if (next_pan < scan->min_pos) next_pan = scan->min_pos;
+		else if (next_pan > scan->max_pos) next_pan = scan->max_pos;
+		if (next_tilt < scan->min_pos) next_tilt = scan->min_pos;
+		else if (next_tilt > scan->max_pos) next_tilt = scan->max_pos;
+	}
+
+	*pan  = next_pan;
+	*tilt = next_tilt;
+	if (++scan->index >= scan->table->count) scan->index = 0;
+}
+
+// Parses "raster", "spiral", "heading" or "none"; returns -1 if unknown
+int search_pattern_parse(const char *name);
+const char *search_pattern_name(enum SearchPatternKind kind);
+
+#endif
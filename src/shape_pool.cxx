@@ -0,0 +1,51 @@
+#include <string.h>
+#include "shape_pool.h"
+
+void shape_pool_init(struct ShapePool *pool)
+{
+	for (int s = 0; s < SHAPE_POOL_SIZE; s++)
+	{
+		pool->slot[s].sample.color = pool->slot[s].color;
+		pool->slot[s].color[0] = '\0';
+		pool->slot[s].next_free = s + 1;
+	}
+	pool->slot[SHAPE_POOL_SIZE - 1].next_free = -1;
+	pool->free_head = 0;
+	pool->in_use = 0;
+	pool->high_water = 0;
+	pool->exhausted = 0;
+}
+
+ShapeTypeExtended *shape_pool_acquire(struct ShapePool *pool)
+{
+	struct ShapePoolSlot *slot;
+
+	if (pool->free_head < 0)
+	{
+		pool->exhausted++;
+		return NULL;
+	}
+
+	slot = &pool->slot[pool->free_head];
+	pool->free_head = slot->next_free;
+	if (++pool->in_use > pool->high_water)
+		pool->high_water = pool->in_use;
+
+	// Keeps the slot's color buffer, just empties it
+	slot->sample.color = slot->color;
+	ShapeTypeExtended_initialize_ex(&slot->sample, RTI_TRUE, RTI_FALSE);
+
+	return &slot->sample;
+}
+
+void shape_pool_release(struct ShapePool *pool, ShapeTypeExtended *sample)
+{
+	int index;
+
+	if (sample == NULL) return;
+
+	index = (int) (((char *) sample - (char *) pool->slot) / sizeof(pool->slot[0]));
+	pool->slot[index].next_free = pool->free_head;
+	pool->free_head = index;
+	pool->in_use--;
+}
@@ -0,0 +1,45 @@
+//-------------------------------------------------------------------
+// shape_pool.h - preallocated ShapeTypeExtended samples
+//
+// ShapeTypeExtended_initialize() allocates a 129 byte color string
+// and _finalize() frees it, so creating samples per observation puts
+// the allocator on the hot path.  The pool owns a fixed number of
+// cache-line aligned slots, each with its own color buffer, and hands
+// samples out from a free list already initialized with
+// allocateMemory = false semantics.  Pooled samples must go back to
+// the pool, never through ShapeTypeExtended_finalize().
+//
+// Not thread-safe: a pool belongs to one control loop.
+//-------------------------------------------------------------------
+#ifndef SHAPE_POOL_H
+#define SHAPE_POOL_H
+
+#include <stdint.h>
+#include "ShapeType.h"
+
+#define SHAPE_POOL_SIZE      16
+#define SHAPE_POOL_COLOR_LEN (128 + 1)    // ShapeType color is string<128>
+
+struct ShapePoolSlot {
+	ShapeTypeExtended sample;
+	char color[SHAPE_POOL_COLOR_LEN];
+	int  next_free;
+} __attribute__((aligned(64)));
+
+struct ShapePool {
+	struct ShapePoolSlot slot[SHAPE_POOL_SIZE];
+	int      free_head;
+	int      in_use;
+	int      high_water;     // most slots ever out at once
+	uint64_t exhausted;      // acquires that found the pool empty
+};
+
+void shape_pool_init(struct ShapePool *pool);
+
+// Returns an initialized sample (empty color, zeroed fields), or NULL
+// when every slot is out
+ShapeTypeExtended *shape_pool_acquire(struct ShapePool *pool);
+
+void shape_pool_release(struct ShapePool *pool, ShapeTypeExtended *sample);
+
+#endif
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "stage_profile.h"
+
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+static const char *stageName[PROFILE_STAGE_COUNT] = { "poll", "ingest", "control", "publish" };
+
+// Per-thread state; slot[] is the counter's position in a group read
+static __thread int leader = -1;
+static __thread int members = 0;
+static __thread bool user_only = false;
+static __thread bool started = false;
+static __thread int fd[PROFILE_COUNTER_COUNT];
+static __thread int slot[PROFILE_COUNTER_COUNT];
+static __thread uint64_t start[PROFILE_COUNTER_COUNT + 1];
+static __thread struct StageTotals totals[PROFILE_STAGE_COUNT];
+static __thread struct StageTotals overhead;
+
+#if defined(__linux__)
+
+static const struct {
+	uint32_t type;
+	uint64_t config;
+} events[PROFILE_COUNTER_COUNT] = {
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+	{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+	{ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES }
+};
+
+// The leader starts disabled so the whole group is enabled at once
+static int open_event(int c, int group_fd, bool exclude_kernel)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = events[c].type;
+	attr.config = events[c].config;
+	attr.read_format = PERF_FORMAT_GROUP;
+	attr.disabled = (group_fd < 0);
+	attr.exclude_kernel = exclude_kernel;
+	attr.exclude_hv = 1;
+
+	return (int) syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+// Counters the PMU lacks (e.g. in a VM) are skipped, not fatal
+static int open_group(bool exclude_kernel)
+{
+	for (int c = 0; c < PROFILE_COUNTER_COUNT; c++)
+	{
+		fd[c] = open_event(c, leader, exclude_kernel);
+		slot[c] = -1;
+		if (fd[c] < 0) continue;
+		if (leader < 0) leader = fd[c];
+		slot[c] = members++;
+	}
+
+	return members;
+}
+
+static bool read_group(uint64_t value[PROFILE_COUNTER_COUNT + 1])
+{
+	ssize_t len = (ssize_t) ((members + 1) * sizeof(uint64_t));
+
+	return read(leader, value, len) == len;
+}
+
+int stage_profile_open(void)
+{
+	if (leader >= 0) return 0;
+
+	members = 0;
+	user_only = false;
+	if ((open_group(false) == 0) && ((errno == EACCES) || (errno == EPERM)))
+	{
+		user_only = true;
+		open_group(true);
+	}
+	if (leader < 0) return -1;
+
+	memset(totals, 0, sizeof(totals));
+	memset(&overhead, 0, sizeof(overhead));
+	ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+	// What a begin/end pair costs by itself
+	for (int i = 0; i < PROFILE_CALIBRATION_PAIRS; i++)
+	{
+		stage_profile_begin();
+		stage_profile_end(PROFILE_POLL);
+	}
+	overhead = totals[PROFILE_POLL];
+	memset(&totals[PROFILE_POLL], 0, sizeof(totals[PROFILE_POLL]));
+
+	return 0;
+}
+
+void stage_profile_close(void)
+{
+	if (leader < 0) return;
+
+	ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	for (int c = 0; c < PROFILE_COUNTER_COUNT; c++)
+		if (fd[c] >= 0) close(fd[c]);
+	leader = -1;
+	members = 0;
+	started = false;
+}
+
+void stage_profile_begin(void)
+{
+	if (leader < 0) return;
+
+	started = read_group(start);
+}
+
+void stage_profile_end(enum ProfileStage stage)
+{
+	uint64_t now[PROFILE_COUNTER_COUNT + 1];
+	struct StageTotals *t = &totals[stage];
+
+	if (!started) return;
+	started = false;
+	if (!read_group(now)) return;
+
+	t->calls++;
+	for (int c = 0; c < PROFILE_COUNTER_COUNT; c++)
+		if (slot[c] >= 0)
+			t->count[c] += now[slot[c] + 1] - start[slot[c] + 1];
+}
+
+#else
+
+int stage_profile_open(void)
+{
+	errno = ENOSYS;
+	return -1;
+}
+
+void stage_profile_close(void)
+{
+}
+
+void stage_profile_begin(void)
+{
+}
+
+void stage_profile_end(enum ProfileStage stage)
+{
+}
+
+#endif
+
+void stage_profile_report(struct StageReport *report)
+{
+	memset(report, 0, sizeof(*report));
+	report->user_only = user_only;
+	for (int c = 0; c < PROFILE_COUNTER_COUNT; c++)
+		report->counted[c] = (leader >= 0) && (slot[c] >= 0);
+	memcpy(report->stage, totals, sizeof(report->stage));
+	report->overhead = overhead;
+}
+
+static void print_row(const struct StageReport *report, const char *name, const struct StageTotals *t, uint64_t frame_cycles)
+{
+	double calls = (t->calls > 0) ? (double) t->calls : 1.0;
+
+	printf("  %-9s %10llu", name, (unsigned long long) t->calls);
+	for (int c = 0; c < PROFILE_COUNTER_COUNT; c++)
+	{
+		if (!report->counted[c])
+			printf(" %11s", "-");
+		else if (c == PROFILE_CONTEXT_SWITCHES)
+			printf(" %11llu", (unsigned long long) t->count[c]);
+		else
+			printf(" %11.1f", (double) t->count[c] / calls);
+	}
+	if (report->counted[PROFILE_CYCLES] && report->counted[PROFILE_INSTRUCTIONS] && (t->count[PROFILE_CYCLES] > 0))
+		printf(" %5.2f", (double) t->count[PROFILE_INSTRUCTIONS] / (double) t->count[PROFILE_CYCLES]);
+	else
+		printf(" %5s", "-");
+	if ((frame_cycles > 0) && (t != &report->overhead) && (t != &report->stage[PROFILE_POLL]))
+		printf(" %5.1f%%\n", 100.0 * (double) t->count[PROFILE_CYCLES] / (double) frame_cycles);
+	else
+		printf("\n");
+}
+
+//-------------------------------------------------------------------
+// Per-call averages; context switches are totals.  The share column
+// splits the cycles of one frame (ingest + control + publish).
+//-------------------------------------------------------------------
+void stage_profile_print(const struct StageReport *report, const char *label)
+{
+	uint64_t frame_cycles = 0;
+
+	for (int s = PROFILE_INGEST; s < PROFILE_STAGE_COUNT; s++)
+		frame_cycles += report->stage[s].count[PROFILE_CYCLES];
+
+	printf("\nStage profile %s (%s):\n", label, report->user_only ? "user only" : "user+kernel");
+	printf("  %-9s %10s %11s %11s %11s %11s %11s %5s %6s\n", "stage", "calls",
+			"cycles", "instr", "cache-miss", "branch-miss", "ctx-switch", "IPC", "frame");
+	for (int s = 0; s < PROFILE_STAGE_COUNT; s++)
+		print_row(report, stageName[s], &report->stage[s], frame_cycles);
+	print_row(report, "overhead", &report->overhead, frame_cycles);
+}
@@ -0,0 +1,61 @@
+//-------------------------------------------------------------------
+// stage_profile.h - hardware counter breakdown of the control loop
+//
+// Each tracker thread opens one perf_event group on itself (cycles,
+// instructions, cache misses, branch misses, context switches) and
+// reads it around the loop stages: the take() that finds nothing,
+// the take() that returns a sample, the observation step (calibration,
+// gate and the pan+tilt gimbal_update pair) and the ServoControl
+// write().  Every begin/end is one read() system
+// call, which the counts include; the overhead row, measured with
+// empty pairs when the group is opened, shows how much.  Linux only.
+//-------------------------------------------------------------------
+#ifndef STAGE_PROFILE_H
+#define STAGE_PROFILE_H
+
+#include <stdint.h>
+
+#define PROFILE_CALIBRATION_PAIRS 256   // empty begin/end pairs for the overhead row
+
+enum ProfileStage {
+	PROFILE_POLL,       // take() with no data
+	PROFILE_INGEST,     // take() returning a sample
+	PROFILE_CONTROL,    // control_observe(): calibration, gate, gimbal_update for both axes
+	PROFILE_PUBLISH,    // ServoControl write()
+	PROFILE_STAGE_COUNT
+};
+
+enum ProfileCounter {
+	PROFILE_CYCLES,
+	PROFILE_INSTRUCTIONS,
+	PROFILE_CACHE_MISSES,
+	PROFILE_BRANCH_MISSES,
+	PROFILE_CONTEXT_SWITCHES,
+	PROFILE_COUNTER_COUNT
+};
+
+struct StageTotals {
+	uint64_t calls;
+	uint64_t count[PROFILE_COUNTER_COUNT];
+};
+
+struct StageReport {
+	bool               user_only;                         // kernel excluded by perf_event_paranoid
+	bool               counted[PROFILE_COUNTER_COUNT];    // counters the CPU/kernel provided
+	struct StageTotals stage[PROFILE_STAGE_COUNT];
+	struct StageTotals overhead;                          // empty begin/end pairs
+};
+
+// Opens and starts the counter group for the calling thread.  Returns
+// -1 with errno set when no counter could be opened.
+int  stage_profile_open(void);
+void stage_profile_close(void);
+
+// No-ops on a thread without an open group
+void stage_profile_begin(void);
+void stage_profile_end(enum ProfileStage stage);
+
+void stage_profile_report(struct StageReport *report);
+void stage_profile_print(const struct StageReport *report, const char *label);
+
+#endif
@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <pthread.h>
+#include "TrackerStatus.h"
+#include "TrackerStatusSupport.h"
+#include "tracker.h"
+#include "tracker_time.h"
+#include "status_publisher.h"
+
+#define STATUS_ID_LEN    64       // string bounds in model/TrackerStatus.idl
+#define STATUS_COLOR_LEN 128
+
+struct StatusPublisher {
+	DDSDomainParticipant *participant;
+	TrackerStatusDataWriter *writer;
+	TrackerStatus *sample;
+	struct TrackerMetrics *metrics;
+	unsigned int period_ms;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t wakeup;
+	bool running;
+	bool stop;
+
+	// Previous snapshot, so each sample reports the last period only
+	uint64_t last_received;
+	uint64_t last_written;
+	uint64_t last_updates;
+	uint64_t last_error_sq;
+	uint64_t last_latency[METRICS_LATENCY_BUCKETS];
+	int64_t  last_us;
+};
+
+//-------------------------------------------------------------------
+// Turn the metric deltas since the last period into one sample
+//-------------------------------------------------------------------
+static void publish_status(struct StatusPublisher *status)
+{
+	struct TrackerMetrics *m = status->metrics;
+	TrackerStatus *sample = status->sample;
+	uint64_t latency[METRICS_LATENCY_BUCKETS];
+	uint64_t received = metrics_counter(m, METRIC_SAMPLES_RECEIVED);
+	uint64_t written  = metrics_counter(m, METRIC_COMMANDS_WRITTEN);
+	uint64_t updates  = metrics_counter(m, METRIC_CONTROL_UPDATES);
+	uint64_t error_sq = metrics_counter(m, METRIC_ERROR_SQUARED_SUM);
+	int64_t now_us = time_monotonic_us();
+	double seconds = (double) (now_us - status->last_us) / 1e6;
+	float error_rms = 0.0f;
+
+	if (seconds <= 0.0) seconds = 1.0;
+
+	metrics_latency_snapshot(m, latency);
+	for (int b = 0; b < METRICS_LATENCY_BUCKETS; b++)
+	{
+		uint64_t total = latency[b];
+		latency[b] -= status->last_latency[b];
+		status->last_latency[b] = total;
+	}
+
+	if (updates > status->last_updates)
+		error_rms = (float) sqrt((double) (error_sq - status->last_error_sq) / (double) (updates - status->last_updates));
+
+	sample->pan            = (DDS_UnsignedShort) metrics_gauge(m, METRIC_PAN_POSITION);
+	sample->tilt           = (DDS_UnsignedShort) metrics_gauge(m, METRIC_TILT_POSITION);
+	sample->error_rms      = error_rms;
+	sample->input_rate_hz  = (float) ((received - status->last_received) / seconds);
+	sample->output_rate_hz = (float) ((written - status->last_written) / seconds);
+	// Percentiles are histogram bucket upper bounds; the max is exact
+	sample->latency_p50_us = (DDS_UnsignedLong) metrics_latency_quantile(latency, 0.50);
+	sample->latency_p90_us = (DDS_UnsignedLong) metrics_latency_quantile(latency, 0.90);
+	sample->latency_p99_us = (DDS_UnsignedLong) metrics_latency_quantile(latency, 0.99);
+	sample->latency_max_us = (DDS_UnsignedLong) metrics_take_latency_max(m);
+
+	if (status->writer->write(*sample, DDS_HANDLE_NIL) != DDS_RETCODE_OK)
+		fprintf(stderr, "TrackerStatus write error\n");
+
+	status->last_received = received;
+	status->last_written  = written;
+	status->last_updates  = updates;
+	status->last_error_sq = error_sq;
+	status->last_us       = now_us;
+}
+
+static void *status_main(void *arg)
+{
+	struct StatusPublisher *status = (struct StatusPublisher *) arg;
+	int64_t next_us = time_monotonic_us() + (int64_t) status->period_ms * 1000;
+	int64_t deadline_us;
+	struct timespec deadline;
+
+	pthread_mutex_lock(&status->lock);
+	while (!status->stop)
+	{
+		// The schedule runs on the monotonic clock; only the wait itself
+		// is handed to the condition variable as a wall-clock deadline
+		deadline_us = time_realtime_us() + (next_us - time_monotonic_us());
+		deadline.tv_sec  = deadline_us / 1000000;
+		deadline.tv_nsec = (deadline_us % 1000000) * 1000;
+		pthread_cond_timedwait(&status->wakeup, &status->lock, &deadline);
+		if (status->stop) break;
+		if (time_monotonic_us() < next_us) continue;
+
+		pthread_mutex_unlock(&status->lock);
+		publish_status(status);
+		pthread_mutex_lock(&status->lock);
+
+		next_us += (int64_t) status->period_ms * 1000;
+		// After a stall, resume the period from now instead of catching up
+		if (next_us <= time_monotonic_us())
+			next_us = time_monotonic_us() + (int64_t) status->period_ms * 1000;
+	}
+	pthread_mutex_unlock(&status->lock);
+
+	return NULL;
+}
+
+struct StatusPublisher *status_publisher_create(DDSDomainParticipant *participant,
+		struct TrackerMetrics *metrics, int domain_id, const char *color, unsigned int period_ms)
+{
+	struct StatusPublisher *status = NULL;
+	DDSPublisher *publisher = NULL;
+	DDSTopic *topic = NULL;
+	DDSDataWriter *writer = NULL;
+	const char *type_name = TrackerStatusTypeSupport::get_type_name();
+	bool registered = false;
+	char host[STATUS_ID_LEN / 2];
+
+	status = (struct StatusPublisher *) calloc(1, sizeof(*status));
+	if (status == NULL) return NULL;
+	status->participant = participant;
+	status->metrics = metrics;
+	status->period_ms = (period_ms > 0) ? period_ms : STATUS_PERIOD_MS;
+	pthread_mutex_init(&status->lock, NULL);
+	pthread_cond_init(&status->wakeup, NULL);
+
+	if (TrackerStatusTypeSupport::register_type(participant, type_name) != DDS_RETCODE_OK)
+	{
+		fprintf(stderr, "TrackerStatus register type error\n");
+		goto fail;
+	}
+	registered = true;
+
+	publisher = participant->create_publisher(DDS_PUBLISHER_QOS_DEFAULT, NULL, DDS_STATUS_MASK_NONE);
+	topic = participant->create_topic(DEFAULT_TRACKER_STATUS_TOPIC_NAME, type_name, DDS_TOPIC_QOS_DEFAULT, NULL, DDS_STATUS_MASK_NONE);
+	if ((publisher == NULL) || (topic == NULL))
+	{
+		fprintf(stderr, "TrackerStatus publisher/topic error\n");
+		goto fail;
+	}
+	writer = publisher->create_datawriter_with_profile(topic, TRACKER_QOS_LIBRARY, "PixyTracker_Status_Profile", NULL, DDS_STATUS_MASK_NONE);
+	status->writer = TrackerStatusDataWriter::narrow(writer);
+	status->sample = TrackerStatusTypeSupport::create_data();
+	if ((status->writer == NULL) || (status->sample == NULL))
+	{
+		fprintf(stderr, "TrackerStatus writer error\n");
+		goto fail;
+	}
+
+	// Identity fields never change, so set them once
+	gethostname(host, sizeof(host));
+	host[sizeof(host) - 1] = '\0';
+	snprintf(status->sample->tracker_id, STATUS_ID_LEN + 1, "%s/%d", host, (int) getpid());
+	status->sample->domain_id = domain_id;
+	snprintf(status->sample->color, STATUS_COLOR_LEN + 1, "%s", color);
+
+	status->last_us = time_monotonic_us();
+	if (pthread_create(&status->thread, NULL, status_main, status) != 0)
+	{
+		fprintf(stderr, "TrackerStatus thread create error\n");
+		goto fail;
+	}
+	status->running = true;
+
+	return status;
+
+fail:
+	// The participant outlives us, so take back everything created
+	// above rather than leave a registered type behind
+	if (writer != NULL)
+		publisher->delete_datawriter(writer);
+	status->writer = NULL;
+	if (topic != NULL)
+		participant->delete_topic(topic);
+	if (publisher != NULL)
+		participant->delete_publisher(publisher);
+	if (registered)
+		TrackerStatusTypeSupport::unregister_type(participant, type_name);
+	status_publisher_delete(status);
+	return NULL;
+}
+
+void status_publisher_stop(struct StatusPublisher *status)
+{
+	if ((status == NULL) || !status->running) return;
+
+	pthread_mutex_lock(&status->lock);
+	status->stop = true;
+	pthread_cond_signal(&status->wakeup);
+	pthread_mutex_unlock(&status->lock);
+	pthread_join(status->thread, NULL);
+	status->running = false;
+}
+
+void status_publisher_delete(struct StatusPublisher *status)
+{
+	if (status == NULL) return;
+	status_publisher_stop(status);
+
+	if (status->sample != NULL)
+		TrackerStatusTypeSupport::delete_data(status->sample);
+	pthread_cond_destroy(&status->wakeup);
+	pthread_mutex_destroy(&status->lock);
+	free(status);
+}
@@ -0,0 +1,31 @@
+//-------------------------------------------------------------------
+// status_publisher.h - periodic TrackerStatus sample for fleet
+// monitoring (see model/TrackerStatus.idl)
+//
+// The publisher runs on its own thread and only reads the tracker's
+// TrackerMetrics block, so the control loop never waits on it.
+//-------------------------------------------------------------------
+#ifndef STATUS_PUBLISHER_H
+#define STATUS_PUBLISHER_H
+
+#include "ndds/ndds_cpp.h"
+#include "tracker_metrics.h"
+
+#define STATUS_PERIOD_MS 1000
+
+struct StatusPublisher;
+
+// Creates the TrackerStatus topic and writer on the participant and
+// starts publishing every period_ms.  Returns NULL on error.
+struct StatusPublisher *status_publisher_create(DDSDomainParticipant *participant,
+		struct TrackerMetrics *metrics, int domain_id, const char *color, unsigned int period_ms);
+
+// Joins the publishing thread.  Call before deleting the participant's
+// entities.
+void status_publisher_stop(struct StatusPublisher *status);
+
+// Releases the sample.  Call after the participant's entities are
+// gone.
+void status_publisher_delete(struct StatusPublisher *status);
+
+#endif
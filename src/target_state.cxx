@@ -0,0 +1,172 @@
+#include <stddef.h>
+#include "target_state.h"
+
+// Alpha-beta gains in 1/1024ths
+#define TARGET_ALPHA_Q10  512
+#define TARGET_BETA_Q10   102
+
+// Clamp dt so a burst of samples cannot blow up the velocity update
+#define TARGET_MIN_DT_US  1000
+
+#define VARIANCE_MIN (TARGET_GATE_MIN_SIGMA * TARGET_GATE_MIN_SIGMA << (2 * TARGET_FRACTION_BITS))
+#define VARIANCE_MAX (TARGET_GATE_MAX_SIGMA * TARGET_GATE_MAX_SIGMA << (2 * TARGET_FRACTION_BITS))
+
+// Residuals beyond this (past any gate) are clipped before squaring
+#define RESIDUAL_MAX ((TARGET_GATE_MAX_SIGMAS + 1) * TARGET_GATE_MAX_SIGMA << TARGET_FRACTION_BITS)
+
+static const char *stateName[] = {
+	"TRACKING",
+	"COASTING",
+	"LOST"
+};
+
+static int32_t axis_extrapolate(const struct AxisPredictor *axis, int64_t dt_us)
+{
+	return axis->position + (int32_t) (((int64_t) axis->velocity * dt_us) / 1000000);
+}
+
+static int64_t residual_squared(int32_t residual)
+{
+	if (residual >  RESIDUAL_MAX) residual =  RESIDUAL_MAX;
+	if (residual < -RESIDUAL_MAX) residual = -RESIDUAL_MAX;
+	return (int64_t) residual * residual;
+}
+
+//-------------------------------------------------------------------
+// One alpha-beta step for one axis; the residual also feeds the
+// variance the gate scales by
+//-------------------------------------------------------------------
+static void axis_update(struct AxisPredictor *axis, int32_t measured, int64_t dt_us)
+{
+	int32_t predicted = axis_extrapolate(axis, dt_us);
+	int32_t residual  = measured - predicted;
+	int64_t variance  = axis->variance + ((residual_squared(residual) - axis->variance) >> TARGET_VARIANCE_SHIFT);
+
+	if (variance < VARIANCE_MIN) variance = VARIANCE_MIN;
+	if (variance > VARIANCE_MAX) variance = VARIANCE_MAX;
+
+	axis->position = predicted + (int32_t) (((int64_t) residual * TARGET_ALPHA_Q10) >> 10);
+	axis->velocity += (int32_t) ((((int64_t) residual * TARGET_BETA_Q10) >> 10) * 1000000 / dt_us);
+	axis->variance = (int32_t) variance;
+}
+
+// A new target starts with the widest gate
+static void axis_reset(struct AxisPredictor *axis, int32_t measured)
+{
+	axis->position = measured;
+	axis->velocity = 0;
+	axis->variance = VARIANCE_MAX;
+}
+
+void target_init(struct TargetTrack *target, int64_t coast_timeout_us, int64_t lost_timeout_us)
+{
+	target->state = TARGET_LOST;
+	target->pan.position = 0;
+	target->pan.velocity = 0;
+	target->pan.variance = VARIANCE_MAX;
+	target->tilt.position = 0;
+	target->tilt.velocity = 0;
+	target->tilt.variance = VARIANCE_MAX;
+	target->last_observation_us = 0;
+	target->coast_timeout_us = coast_timeout_us;
+	target->lost_timeout_us  = (lost_timeout_us > coast_timeout_us) ? lost_timeout_us : coast_timeout_us;
+	target->gate_q4 = 0;
+	target->initialized = false;
+}
+
+void target_set_gate(struct TargetTrack *target, int32_t sigmas)
+{
+	if (sigmas < 0) sigmas = 0;
+	if (sigmas > TARGET_GATE_MAX_SIGMAS) sigmas = TARGET_GATE_MAX_SIGMAS;
+	target->gate_q4 = (sigmas * sigmas) << 4;
+}
+
+//-------------------------------------------------------------------
+// rp^2 / vp + rt^2 / vt <= g  without the divisions:
+// (rp^2 vt + rt^2 vp) << 4 <= g_q4 vp vt.  With the clips above the
+// largest term stays under 2^62.
+//-------------------------------------------------------------------
+bool target_gate(const struct TargetTrack *target, int32_t pan, int32_t tilt, int64_t now_us)
+{
+	int64_t dt_us = now_us - target->last_observation_us;
+	int64_t pan_variance  = target->pan.variance;
+	int64_t tilt_variance = target->tilt.variance;
+	int64_t distance;
+
+	if ((target->gate_q4 == 0) || (target->state != TARGET_TRACKING) || (dt_us > target->coast_timeout_us))
+		return true;
+
+	distance = residual_squared((pan  << TARGET_FRACTION_BITS) - axis_extrapolate(&target->pan,  dt_us)) * tilt_variance
+	         + residual_squared((tilt << TARGET_FRACTION_BITS) - axis_extrapolate(&target->tilt, dt_us)) * pan_variance;
+
+	return (distance << 4) <= target->gate_q4 * pan_variance * tilt_variance;
+}
+
+void target_observe(struct TargetTrack *target, int32_t pan, int32_t tilt, int64_t now_us)
+{
+	int64_t dt_us = now_us - target->last_observation_us;
+
+	pan  <<= TARGET_FRACTION_BITS;
+	tilt <<= TARGET_FRACTION_BITS;
+
+	// A target that has been gone longer than the lost timeout is a
+	// new target - do not carry its old velocity over
+	if (!target->initialized || (dt_us > target->lost_timeout_us))
+	{
+		axis_reset(&target->pan, pan);
+		axis_reset(&target->tilt, tilt);
+		target->initialized = true;
+	}
+	else
+	{
+		if (dt_us < TARGET_MIN_DT_US) dt_us = TARGET_MIN_DT_US;
+		axis_update(&target->pan, pan, dt_us);
+		axis_update(&target->tilt, tilt, dt_us);
+	}
+
+	target->last_observation_us = now_us;
+	target->state = TARGET_TRACKING;
+}
+
+void target_signal_loss(struct TargetTrack *target, int64_t now_us)
+{
+	if (target->state == TARGET_TRACKING)
+		target->state = TARGET_COASTING;
+}
+
+enum TargetState target_update(struct TargetTrack *target, int64_t now_us)
+{
+	int64_t silent_us = now_us - target->last_observation_us;
+
+	if ((target->state == TARGET_TRACKING) && (silent_us > target->coast_timeout_us))
+		target->state = TARGET_COASTING;
+	if ((target->state == TARGET_COASTING) && (silent_us > target->lost_timeout_us))
+		target->state = TARGET_LOST;
+
+	return target->state;
+}
+
+int64_t target_next_change_us(const struct TargetTrack *target)
+{
+	if (target->state == TARGET_TRACKING)
+		return target->last_observation_us + target->coast_timeout_us + 1;
+	if (target->state == TARGET_COASTING)
+		return target->last_observation_us + target->lost_timeout_us + 1;
+	return INT64_MAX;
+}
+
+void target_predict(const struct TargetTrack *target, int64_t now_us, int32_t *pan, int32_t *tilt)
+{
+	int64_t dt_us = now_us - target->last_observation_us;
+
+	if (dt_us > target->lost_timeout_us) dt_us = target->lost_timeout_us;
+	if (dt_us < 0) dt_us = 0;
+
+	*pan  = axis_extrapolate(&target->pan, dt_us)  >> TARGET_FRACTION_BITS;
+	*tilt = axis_extrapolate(&target->tilt, dt_us) >> TARGET_FRACTION_BITS;
+}
+
+const char *target_state_name(enum TargetState state)
+{
+	return ((unsigned int) state <= TARGET_LOST) ? stateName[state] : "UNKNOWN";
+}
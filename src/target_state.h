@@ -0,0 +1,99 @@
+//-------------------------------------------------------------------
+// target_state.h - target state machine with predictive coasting
+//
+// The target is tracked in servo coordinates (gimbal position plus
+// the image error converted to servo units), so the prediction does
+// not depend on where the camera happens to be pointing.  An
+// alpha-beta filter in fixed point estimates position and velocity
+// per axis:
+//
+//   TRACKING - observations are arriving
+//   COASTING - observations stopped (timeout, instance disposed or
+//              no writers, deadline missed); aim at the prediction
+//   LOST     - coasted too long; hold position and wait
+//
+// While TRACKING an optional validation gate screens observations
+// before they reach the filter or the controller: the residual from
+// the prediction, scaled by a running estimate of each axis' residual
+// variance, must be within the configured number of sigmas
+// (Mahalanobis distance, diagonal covariance).  The test is integer
+// multiplies and one compare.  A real jump that the gate keeps
+// rejecting ends in COASTING, where the gate is off, and the next
+// observation is taken as is.
+//
+// All times are CLOCK_MONOTONIC microseconds.
+//-------------------------------------------------------------------
+#ifndef TARGET_STATE_H
+#define TARGET_STATE_H
+
+#include <stdint.h>
+
+#define TARGET_COAST_TIMEOUT_US  200000   // no data for this long -> coasting
+#define TARGET_LOST_TIMEOUT_US   1500000  // no data for this long -> lost
+
+enum TargetState {
+	TARGET_TRACKING,
+	TARGET_COASTING,
+	TARGET_LOST
+};
+
+// Position in servo units << TARGET_FRACTION_BITS, velocity in the
+// same units per second
+#define TARGET_FRACTION_BITS 4
+
+// Residual variance, same fraction bits squared, kept between the
+// squares of these (servo units) so the gate is never tighter than
+// servo resolution and its products stay in 64 bits
+#define TARGET_GATE_MIN_SIGMA  4
+#define TARGET_GATE_MAX_SIGMA  256
+#define TARGET_GATE_MAX_SIGMAS 16
+#define TARGET_VARIANCE_SHIFT  3          // 1/8 of each new squared residual
+
+struct AxisPredictor {
+	int32_t position;
+	int32_t velocity;
+	int32_t variance;
+};
+
+struct TargetTrack {
+	enum TargetState state;
+	struct AxisPredictor pan;
+	struct AxisPredictor tilt;
+	int64_t last_observation_us;
+	int64_t coast_timeout_us;
+	int64_t lost_timeout_us;
+	int32_t gate_q4;                 // squared distance limit << 4; 0 = no gate
+	bool    initialized;
+};
+
+void target_init(struct TargetTrack *target, int64_t coast_timeout_us, int64_t lost_timeout_us);
+
+// Gate observations at this many sigmas (1..TARGET_GATE_MAX_SIGMAS);
+// 0 turns the gate off, which is the default
+void target_set_gate(struct TargetTrack *target, int32_t sigmas);
+
+// True if an observation (servo units) at now_us passes the gate, or
+// there is no gate to pass: no gate set, or not TRACKING
+bool target_gate(const struct TargetTrack *target, int32_t pan, int32_t tilt, int64_t now_us);
+
+// Feed one observation (servo units).  Always moves to TRACKING.
+void target_observe(struct TargetTrack *target, int32_t pan, int32_t tilt, int64_t now_us);
+
+// The source of the target went away (disposed, no writers, deadline
+// missed).  TRACKING moves straight to COASTING.
+void target_signal_loss(struct TargetTrack *target, int64_t now_us);
+
+// Applies the timeouts and returns the current state
+enum TargetState target_update(struct TargetTrack *target, int64_t now_us);
+
+// The first time target_update() would move to the next state;
+// INT64_MAX once lost
+int64_t target_next_change_us(const struct TargetTrack *target);
+
+// Predicted position (servo units) at now_us.  Extrapolation stops at
+// the lost timeout so a stale velocity cannot run away.
+void target_predict(const struct TargetTrack *target, int64_t now_us, int32_t *pan, int32_t *tilt);
+
+const char *target_state_name(enum TargetState state);
+
+#endif
@@ -0,0 +1,208 @@
+#include <string.h>
+#include "target_table.h"
+
+static const char *policyName[] = {
+	"nearest",
+	"largest",
+	"sticky"
+};
+
+static int find_slot(const struct TargetTable *table, const struct TargetKey *key)
+{
+	for (int slot = 0; slot < TARGET_TABLE_SIZE; slot++)
+	{
+		if ((table->used & (1u << slot)) && target_key_equal(&table->key[slot], key))
+			return slot;
+	}
+	return TARGET_NONE;
+}
+
+static void release_slot(struct TargetTable *table, int slot)
+{
+	table->used &= ~(1u << slot);
+	if (table->selected == slot)
+		table->selected = TARGET_NONE;
+}
+
+static int32_t aim_distance_sq(const struct TargetTable *table, const struct TargetCandidate *c)
+{
+	int32_t dx = c->x - table->aim_x;
+	int32_t dy = c->y - table->aim_y;
+
+	return dx * dx + dy * dy;
+}
+
+//-------------------------------------------------------------------
+// Whether the challenger is nearer than the current candidate by more
+// than the margin in real distance, dc + m < dd, without a square
+// root: with A = dd^2 - dc^2 - m^2 that is A > 0 and A^2 > 4 m^2 dc^2
+//-------------------------------------------------------------------
+static bool nearer_by_margin(int32_t challenger_sq, int32_t current_sq, int32_t margin)
+{
+	int64_t a = (int64_t) current_sq - challenger_sq - (int64_t) margin * margin;
+
+	return (a > 0) && (a * a > 4 * (int64_t) margin * margin * challenger_sq);
+}
+
+void target_table_init(struct TargetTable *table, enum TargetPolicy policy, int32_t aim_x, int32_t aim_y, int64_t expiry_us)
+{
+	memset(table, 0, sizeof(*table));
+	table->selected = TARGET_NONE;
+	table->policy = policy;
+	table->aim_x = aim_x;
+	table->aim_y = aim_y;
+	table->expiry_us = expiry_us;
+}
+
+enum TargetOrder target_table_order(const struct TargetTable *table, const struct TargetKey *key,
+		int64_t source_us, int64_t sequence)
+{
+	int slot = find_slot(table, key);
+
+	if (slot == TARGET_NONE) return TARGET_ORDER_OK;
+	// Equal timestamps are fine (coarse clocks); the sequence number decides
+	if (source_us < table->candidate[slot].last_source_us) return TARGET_ORDER_OLD_TIMESTAMP;
+	if (sequence <= table->candidate[slot].last_sequence) return TARGET_ORDER_OLD_SEQUENCE;
+
+	return TARGET_ORDER_OK;
+}
+
+int target_table_observe(struct TargetTable *table, const struct TargetKey *key,
+		int32_t x, int32_t y, int32_t size, int64_t now_us, int64_t source_us, int64_t sequence)
+{
+	struct TargetCandidate *c;
+	int slot = find_slot(table, key);
+
+	if (slot == TARGET_NONE)
+	{
+		if (table->used != (1u << TARGET_TABLE_SIZE) - 1)
+		{
+			slot = __builtin_ctz(~table->used);
+		}
+		else
+		{
+			// Full: evict the stalest candidate that is not selected
+			int64_t oldest = now_us + 1;
+			for (int s = 0; s < TARGET_TABLE_SIZE; s++)
+			{
+				if ((s != table->selected) && (table->candidate[s].last_seen_us < oldest))
+				{
+					oldest = table->candidate[s].last_seen_us;
+					slot = s;
+				}
+			}
+		}
+		table->key[slot] = *key;
+		table->candidate[slot].first_seen_us = now_us;
+		table->used |= 1u << slot;
+	}
+
+	c = &table->candidate[slot];
+	c->x = x;
+	c->y = y;
+	c->size = size;
+	c->last_seen_us = now_us;
+	c->last_source_us = source_us;
+	c->last_sequence = sequence;
+
+	return slot;
+}
+
+void target_table_remove(struct TargetTable *table, const struct TargetKey *key)
+{
+	int slot = find_slot(table, key);
+
+	if (slot != TARGET_NONE)
+		release_slot(table, slot);
+}
+
+void target_table_clear(struct TargetTable *table)
+{
+	table->used = 0;
+	table->selected = TARGET_NONE;
+}
+
+//-------------------------------------------------------------------
+// Pick the candidate the policy prefers.  NEAREST and LARGEST only
+// switch away from the current choice when the challenger is clearly
+// better, so two similar balls do not make the gimbal oscillate.
+//-------------------------------------------------------------------
+int target_table_select(struct TargetTable *table, int64_t now_us)
+{
+	int best = TARGET_NONE;
+
+	for (int slot = 0; slot < TARGET_TABLE_SIZE; slot++)
+	{
+		if ((table->used & (1u << slot)) && (now_us - table->candidate[slot].last_seen_us > table->expiry_us))
+			release_slot(table, slot);
+	}
+	if (table->used == 0) return TARGET_NONE;
+
+	for (int slot = 0; slot < TARGET_TABLE_SIZE; slot++)
+	{
+		const struct TargetCandidate *c = &table->candidate[slot];
+
+		if (!(table->used & (1u << slot))) continue;
+		if (best == TARGET_NONE)
+		{
+			best = slot;
+			continue;
+		}
+		switch (table->policy)
+		{
+		case TARGET_POLICY_NEAREST:
+			if (aim_distance_sq(table, c) < aim_distance_sq(table, &table->candidate[best]))
+				best = slot;
+			break;
+		case TARGET_POLICY_LARGEST:
+			if (c->size > table->candidate[best].size)
+				best = slot;
+			break;
+		case TARGET_POLICY_STICKY:
+			if (c->first_seen_us < table->candidate[best].first_seen_us)
+				best = slot;
+			break;
+		}
+	}
+
+	if ((table->selected != TARGET_NONE) && (best != table->selected))
+	{
+		const struct TargetCandidate *current = &table->candidate[table->selected];
+		const struct TargetCandidate *challenger = &table->candidate[best];
+
+		switch (table->policy)
+		{
+		case TARGET_POLICY_NEAREST:
+			if (!nearer_by_margin(aim_distance_sq(table, challenger), aim_distance_sq(table, current),
+					TARGET_SWITCH_MARGIN_PIXELS))
+				best = table->selected;
+			break;
+		case TARGET_POLICY_LARGEST:
+			if (challenger->size < current->size + TARGET_SWITCH_MARGIN_SIZE)
+				best = table->selected;
+			break;
+		case TARGET_POLICY_STICKY:
+			// Sticky never lets go of a live candidate
+			best = table->selected;
+			break;
+		}
+	}
+
+	table->selected = best;
+	return best;
+}
+
+int target_table_count(const struct TargetTable *table)
+{
+	return __builtin_popcount(table->used);
+}
+
+int target_policy_parse(const char *name)
+{
+	for (int policy = TARGET_POLICY_NEAREST; policy <= TARGET_POLICY_STICKY; policy++)
+	{
+		if (strcmp(name, policyName[policy]) == 0)
+			return policy;
+	}
+	return -1;
+}
@@ -0,0 +1,97 @@
+//-------------------------------------------------------------------
+// target_table.h - per-publication candidate targets
+//
+// `color` is the key of ShapeType, so every publisher of a GREEN
+// circle writes the same instance.  The table keeps one candidate per
+// publication handle and a selection policy decides which one drives
+// the gimbal; samples from the others are dropped instead of making
+// the camera hop between balls.
+//
+// Keys are kept apart from the candidate state so a lookup scans two
+// cache lines at most.
+//-------------------------------------------------------------------
+#ifndef TARGET_TABLE_H
+#define TARGET_TABLE_H
+
+#include <stdint.h>
+
+#define TARGET_TABLE_SIZE 8
+#define TARGET_NONE       (-1)
+
+// A challenger must beat the selected candidate by this much before
+// NEAREST/LARGEST switch over
+#define TARGET_SWITCH_MARGIN_PIXELS 16
+#define TARGET_SWITCH_MARGIN_SIZE   8
+
+enum TargetPolicy {
+	TARGET_POLICY_NEAREST,  // closest to the aim point
+	TARGET_POLICY_LARGEST,  // largest shapesize
+	TARGET_POLICY_STICKY    // first publisher seen, until it goes away
+};
+
+struct TargetKey {
+	uint64_t high;
+	uint64_t low;
+};
+
+static inline bool target_key_equal(const struct TargetKey *a, const struct TargetKey *b)
+{
+	return (a->high == b->high) && (a->low == b->low);
+}
+
+enum TargetOrder {
+	TARGET_ORDER_OK,
+	TARGET_ORDER_OLD_TIMESTAMP,   // source timestamp older than the last accepted
+	TARGET_ORDER_OLD_SEQUENCE     // sequence number not past the last accepted
+};
+
+struct TargetCandidate {
+	int32_t x;
+	int32_t y;
+	int32_t size;
+	int32_t pad;
+	int64_t first_seen_us;
+	int64_t last_seen_us;
+	int64_t last_source_us;       // newest accepted source timestamp
+	int64_t last_sequence;        // and its publication sequence number
+};
+
+struct TargetTable {
+	struct TargetKey key[TARGET_TABLE_SIZE] __attribute__((aligned(64)));
+	struct TargetCandidate candidate[TARGET_TABLE_SIZE] __attribute__((aligned(64)));
+	uint32_t used;            // bit per slot
+	int selected;
+	enum TargetPolicy policy;
+	int32_t aim_x;
+	int32_t aim_y;
+	int64_t expiry_us;        // candidates silent this long are dropped
+};
+
+void target_table_init(struct TargetTable *table, enum TargetPolicy policy, int32_t aim_x, int32_t aim_y, int64_t expiry_us);
+
+// Whether an observation is newer than everything accepted from the
+// same publication.  Unknown publications are always in order.
+enum TargetOrder target_table_order(const struct TargetTable *table, const struct TargetKey *key,
+		int64_t source_us, int64_t sequence);
+
+// Records an observation and returns its slot.  When the table is full
+// the stalest unselected candidate is replaced.
+int target_table_observe(struct TargetTable *table, const struct TargetKey *key,
+		int32_t x, int32_t y, int32_t size, int64_t now_us, int64_t source_us, int64_t sequence);
+
+// Drops one publication (it disposed the instance)
+void target_table_remove(struct TargetTable *table, const struct TargetKey *key);
+
+// Drops every candidate (no writers left)
+void target_table_clear(struct TargetTable *table);
+
+// Expires silent candidates, applies the policy and returns the
+// selected slot or TARGET_NONE
+int target_table_select(struct TargetTable *table, int64_t now_us);
+
+int target_table_count(const struct TargetTable *table);
+
+// Parses "nearest", "largest" or "sticky"; returns -1 if unknown
+int target_policy_parse(const char *name);
+
+#endif
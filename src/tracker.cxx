@@ -4,19 +4,37 @@
 #include <ctype.h>
 #include <signal.h>
 #include <string.h>
+#include <pthread.h>
+#include <errno.h>
 //#include "pixy.h"
 #include "ShapeType.h"
 #include "ShapeTypeSupport.h"
 #include "ServoControl.h"
 #include "ServoControlSupport.h"
+#include "tracker_metrics.h"
+#include "tracker_time.h"
+#include "status_publisher.h"
+#include "target_state.h"
+#include "search_pattern.h"
+#include "target_table.h"
+#include "calibration.h"
+#include "trajectory.h"
+#include "bench.h"
+#include "alloc_check.h"
+#include "stage_profile.h"
+#include "tracker_probes.h"
+#include "gimbal_head.h"
+#include "control.h"
+#include "replay.h"
+#include "shape_pool.h"
+#include "qos_bench.h"
+#include "demux_bench.h"
+#include "roi_filter.h"
+#include "tracker.h"
 
 #include "ndds/ndds_cpp.h"
 
-static bool run_flag = true;
-static bool got_matched_publisher = false;
-static bool got_matched_subscriber = false;
-
-#define NUM_SIGS 7
+static bool run_flag = true;       // read by every domain thread; __atomic only
 
 const char *sigName[] = {
     "RED",
@@ -28,6 +46,13 @@ const char *sigName[] = {
     "PURPLE"
 };
 
+const struct TrackerQosProfile trackerQosProfiles[] = {
+	{ "default",     TRACKER_QOS_PROFILE,               "Connext defaults for reliability and history" },
+	{ "best-effort", "PixyTracker_BestEffort_Profile",  "best-effort, keep last 1, servo lifespan 100 ms" },
+	{ "low-latency", "PixyTracker_LowLatency_Profile",  "reliable, keep last 1, immediate repairs, servo lifespan 100 ms" }
+};
+const int trackerQosProfileCount = sizeof(trackerQosProfiles) / sizeof(trackerQosProfiles[0]);
+
 #define INDEX_RED  0
 #define INDEX_ORANGE 1
 #define INDEX_YELLOW 2
@@ -41,6 +66,9 @@ const char *sigName[] = {
 #define S1_LOWER_LIMIT -200
 #define S1_UPPER_LIMIT 200
 #define SERVO_FREQUENCY_HZ 60
+#define METRICS_PERIOD_MS 1000
+#define DEFAULT_DOMAIN_ID 53
+#define TRACKER_MAX_DOMAINS METRICS_MAX_INSTANCES
 
 // Pixy x-y position values
  #define PIXY_MIN_X                  0
@@ -48,55 +76,38 @@ const char *sigName[] = {
  #define PIXY_MIN_Y                  0
  #define PIXY_MAX_Y                  199
 
- // RC-servo values
- #define PIXY_RCS_MIN_POS            0
- #define PIXY_RCS_MAX_POS            1000
- #define PIXY_RCS_CENTER_POS         ((PIXY_RCS_MAX_POS-PIXY_RCS_MIN_POS)/2)
-
-// PID control parameters //
-//#define PAN_PROPORTIONAL_GAIN     400	// 400 350
-//#define PAN_DERIVATIVE_GAIN       300	// 300 600
-//#define TILT_PROPORTIONAL_GAIN    500	// 500 500
-//#define TILT_DERIVATIVE_GAIN      300	// 400 700
-
-#define PAN_PROPORTIONAL_GAIN     300	// 400 350
-#define PAN_DERIVATIVE_GAIN       200	// 300 600
-#define TILT_PROPORTIONAL_GAIN    350	// 500 500
-#define TILT_DERIVATIVE_GAIN      300	// 400 700
-
-#define SHAPE_X_MIN 0
-#define SHAPE_X_MAX 222
-#define SHAPE_Y_MIN 0
-#define SHAPE_Y_MAX 252
-
-#define PIXY_X_CENTER              ((SHAPE_X_MAX-SHAPE_X_MIN)/2)
-#define PIXY_Y_CENTER              ((SHAPE_Y_MAX-SHAPE_Y_MIN)/2)
-
 // These values will keep the tracked ball centered over the orange dot over the "i" in "rti" in the Shapes demo.
 // Useful if you're tracking the orange ball.
 //#define PIXY_X_CENTER              (168)
 //#define PIXY_Y_CENTER              (89)
 
-// Local prototypes
-void handle_SIGINT(int unused);
-void initialize_gimbals(void);
-int track (int domainId, unsigned int);
-int main (int argc, char *argv[]);
-
 //-------------------------------------------------------------------
-// We'll need one of these for pan, and one for tilt.  Holds
-// variables for running the tracking algorithm
+// Servo output stage.  With a trajectory mode the controller only
+// moves the targets; the commands go out once per servo tick.
 //-------------------------------------------------------------------
-struct Gimbal {
-  int32_t position;
-  int32_t previous_error;
-  int32_t proportional_gain;
-  int32_t derivative_gain;
+struct ServoOutput {
+	bool    shaped;
+	bool    stamped;             // commands carry their observation's source timestamp
+	struct TrajectoryAxis pan;
+	struct TrajectoryAxis tilt;
+	int64_t next_tick_us;
+	int64_t pending_source_us;   // observation behind the newest target
 };
 
-struct Gimbal pan;
-struct Gimbal tilt;
+//-------------------------------------------------------------------
+// One tracker thread per domain; each owns its participant and its
+// controller state
+//-------------------------------------------------------------------
+struct DomainTracker {
+	int domain_id;
+	const struct TrackerConfig *config;
+	pthread_t thread;
+	int result;
+};
 
+// Local prototypes
+void handle_SIGINT(int unused);
+int main (int argc, char *argv[]);
 
 //-------------------------------------------------------------------
 // handle_SIGINT - sets flag for orderly shutdown on Ctrl-C
@@ -105,56 +116,22 @@ void handle_SIGINT(int unused)
 {
   // On CTRL+C - abort! //
 
-  run_flag = false;
+  __atomic_store_n(&run_flag, false, __ATOMIC_RELAXED);
 }
 
-//-------------------------------------------------------------------
-// Setup the gimbal control structures
-//-------------------------------------------------------------------
-void initialize_gimbals(void)
+void tracker_set_running(bool running)
 {
-	pan.position = PIXY_RCS_CENTER_POS;
-	pan.previous_error     = 0x80000000L;
-	pan.proportional_gain  = PAN_PROPORTIONAL_GAIN;
-	pan.derivative_gain    = PAN_DERIVATIVE_GAIN;
-	tilt.position          = PIXY_RCS_CENTER_POS;
-	tilt.previous_error    = 0x80000000L;
-	tilt.proportional_gain = TILT_PROPORTIONAL_GAIN;
-	tilt.derivative_gain   = TILT_DERIVATIVE_GAIN;
+	__atomic_store_n(&run_flag, running, __ATOMIC_RELAXED);
 }
 
-//-------------------------------------------------------------------
-// This is the control loop for each axis of the cam control (pan/tilt)
-//-------------------------------------------------------------------
-void gimbal_update(struct Gimbal *  gimbal, int32_t error)
+const char *tracker_qos_profile(const char *name)
 {
-	long int velocity;
-	int32_t  error_delta;
-	int32_t  P_gain;
-	int32_t  D_gain;
-
-	if(gimbal->previous_error != 0x80000000L)
+	for (int p = 0; p < trackerQosProfileCount; p++)
 	{
-		error_delta = error - gimbal->previous_error;
-		P_gain      = gimbal->proportional_gain;
-		D_gain      = gimbal->derivative_gain;
-
-		/* Using the proportional and derivative gain for the gimbal,
-	   	   calculate the change to the position.  */
-		velocity = (error * P_gain + error_delta * D_gain) >> 10;
-
-		gimbal->position += velocity;
-
-		if (gimbal->position > PIXY_RCS_MAX_POS)
-		{
-			gimbal->position = PIXY_RCS_MAX_POS;
-		} else if (gimbal->position < PIXY_RCS_MIN_POS)
-		{
-			gimbal->position = PIXY_RCS_MIN_POS;
-		}
+		if ((strcmp(name, trackerQosProfiles[p].name) == 0) || (strcmp(name, trackerQosProfiles[p].profile) == 0))
+			return trackerQosProfiles[p].profile;
 	}
-
-  gimbal->previous_error = error;
+	return name;
 }
 
 //-------------------------------------------------------------------
@@ -163,6 +140,8 @@ void gimbal_update(struct Gimbal *  gimbal, int32_t error)
 class ServoTypeListener : public DDSDataWriterListener
 {
 public:
+	ServoTypeListener(struct TrackerMetrics *m) : metrics(m) {}
+
 	virtual void on_offered_deadline_missed (
 			DDSDataWriter *writer,
 			const DDS_OfferedDeadlineMissedStatus &status)  {}
@@ -190,10 +169,14 @@ public:
 
 	virtual void on_service_request_accepted (DDSDataWriter *writer,
 			const DDS_ServiceRequestAcceptedStatus &status) {}
+
+private:
+	struct TrackerMetrics *metrics;
 };
 
 void ServoTypeListener::on_publication_matched(DDSDataWriter *writer, const DDS_PublicationMatchedStatus &status)
 {
+	AllocCheckScope alloc_scope;
 	ServoControlDataWriter *servo_writer = NULL;
 	DDS_ReturnCode_t retcode;
 
@@ -202,10 +185,9 @@ void ServoTypeListener::on_publication_matched(DDSDataWriter *writer, const DDS_
 
 	printf("\n");
 	printf("Subs: %d %d\n", status.current_count, status.current_count_change);
-	if (status.current_count > 0)
-		got_matched_subscriber = true;
-	else
-		got_matched_subscriber = false;
+	TRACKER_PROBE2(publication_matched, (metrics != NULL) ? metrics->label : "", status.current_count);
+	if (metrics != NULL)
+		metrics_set(metrics, METRIC_MATCHED_SUBSCRIBERS, status.current_count);
 
 	return;
 }
@@ -216,9 +198,18 @@ void ServoTypeListener::on_publication_matched(DDSDataWriter *writer, const DDS_
 class ShapeTypeListener : public DDSDataReaderListener
 {
 public:
+    ShapeTypeListener(struct TrackerMetrics *m) : metrics(m), deadline_missed(false) {}
+
+    // Only fires when the active profile requests a deadline on the
+    // reader; the control loop picks the flag up on its next pass.
     virtual void on_requested_deadline_missed(
         DDSDataReader* /*reader*/,
-        const DDS_RequestedDeadlineMissedStatus& /*status*/) {}
+        const DDS_RequestedDeadlineMissedStatus& /*status*/)
+    {
+        AllocCheckScope alloc_scope;
+        TRACKER_PROBE1(deadline_missed, (metrics != NULL) ? metrics->label : "");
+        __atomic_store_n(&deadline_missed, true, __ATOMIC_RELEASE);
+    }
 
     virtual void on_requested_incompatible_qos(
         DDSDataReader* /*reader*/,
@@ -242,11 +233,20 @@ public:
 
     virtual void on_data_available(DDSDataReader* reader){}
 
+    bool take_deadline_missed(void)
+    {
+        return __atomic_exchange_n(&deadline_missed, false, __ATOMIC_ACQ_REL);
+    }
+
+private:
+    struct TrackerMetrics *metrics;
+    bool deadline_missed;
 };
 
 
 void ShapeTypeListener::on_subscription_matched(DDSDataReader *reader, const DDS_SubscriptionMatchedStatus &status)
 {
+	AllocCheckScope alloc_scope;
 	ShapeTypeExtendedDataReader *shape_reader = NULL;
 	DDS_ReturnCode_t retcode;
 
@@ -255,15 +255,148 @@ void ShapeTypeListener::on_subscription_matched(DDSDataReader *reader, const DDS
 
 	printf("\n");
 	printf("Pubs: %d %d\n", status.current_count, status.current_count_change);
-	if (status.current_count > 0)
-		got_matched_publisher = true;
-	else
-		got_matched_publisher = false;
+	TRACKER_PROBE2(subscription_matched, (metrics != NULL) ? metrics->label : "", status.current_count);
+	if (metrics != NULL)
+		metrics_set(metrics, METRIC_MATCHED_PUBLISHERS, status.current_count);
 
 	return;
 }
 
 
+//-------------------------------------------------------------------
+// Candidate targets are keyed by the writer's publication handle
+//-------------------------------------------------------------------
+static void target_key_from_handle(struct TargetKey *key, const DDS_InstanceHandle_t &handle)
+{
+	memcpy(&key->high, &handle.keyHash.value[0], sizeof(key->high));
+	memcpy(&key->low,  &handle.keyHash.value[8], sizeof(key->low));
+}
+
+//-------------------------------------------------------------------
+// Window bounds into the preallocated ROI filter parameters %1..%4
+//-------------------------------------------------------------------
+static void roi_format_params(DDS_StringSeq &params, const struct RoiWindow *window)
+{
+	snprintf(params[1], ROI_PARAM_LEN, "%d", window->x_min);
+	snprintf(params[2], ROI_PARAM_LEN, "%d", window->x_max);
+	snprintf(params[3], ROI_PARAM_LEN, "%d", window->y_min);
+	snprintf(params[4], ROI_PARAM_LEN, "%d", window->y_max);
+}
+
+//-------------------------------------------------------------------
+// Offer this pass's region of interest: while tracking, around where
+// the target should appear in the image now and one update period
+// ahead with the camera at (camera_pan, camera_tilt); otherwise the
+// whole frame.  Returns true, parameters formatted, when the filter
+// should change.
+//-------------------------------------------------------------------
+static bool roi_follow(struct RoiFilter *roi, DDS_StringSeq &params, const struct TargetTrack *target, bool open,
+		int32_t camera_pan, int32_t camera_tilt, int64_t now_us)
+{
+	struct RoiWindow window;
+	int32_t pan[2];
+	int32_t tilt[2];
+
+	if (!open)
+	{
+		target_predict(target, now_us, &pan[0], &tilt[0]);
+		target_predict(target, now_us + roi->period_us, &pan[1], &tilt[1]);
+		// Linear lens model backwards: pan error is PIXY_X_CENTER - x,
+		// tilt error is y - PIXY_Y_CENTER; the margin absorbs calibration
+		roi_filter_window(roi,
+				PIXY_X_CENTER - gimbal_axis_to_error<PanAxis>(pan[0]  - camera_pan),
+				PIXY_Y_CENTER + gimbal_axis_to_error<TiltAxis>(tilt[0] - camera_tilt),
+				PIXY_X_CENTER - gimbal_axis_to_error<PanAxis>(pan[1]  - camera_pan),
+				PIXY_Y_CENTER + gimbal_axis_to_error<TiltAxis>(tilt[1] - camera_tilt),
+				PIXY_X_CENTER, PIXY_Y_CENTER, SHAPE_X_MAX, SHAPE_Y_MAX, &window);
+	}
+	if (!roi_filter_propose(roi, open ? NULL : &window, now_us))
+		return false;
+
+	roi_format_params(params, &roi->window);
+	return true;
+}
+
+//-------------------------------------------------------------------
+// Write one servo command and account for it.  source_us is the
+// source timestamp of the observation behind the command, or 0 when
+// the command was not driven by an observation.  Stamped commands
+// reuse it as their own source timestamp so a subscriber can measure
+// observation-to-command latency.
+//-------------------------------------------------------------------
+static void write_servo_command(ServoControlDataWriter *servo_writer, const ServoControl &servo_control,
+		struct TrackerMetrics *metrics, int64_t source_us, bool stamped)
+{
+	DDS_ReturnCode_t retcode;
+	DDS_Time_t stamp;
+	int64_t latency_us;
+
+	stage_profile_begin();
+	if (stamped && (source_us != 0))
+	{
+		stamp.sec = (DDS_Long) (source_us / 1000000);
+		stamp.nanosec = (DDS_UnsignedLong) (source_us % 1000000) * 1000;
+		retcode = servo_writer->write_w_timestamp(servo_control, DDS_HANDLE_NIL, stamp);
+	}
+	else
+		retcode = servo_writer->write(servo_control, DDS_HANDLE_NIL);
+	stage_profile_end(PROFILE_PUBLISH);
+	TRACKER_PROBE5(servo_write, metrics->label, servo_control.pan, servo_control.tilt, source_us, retcode);
+	if (retcode == DDS_RETCODE_OK)
+	{
+		metrics_count(metrics, METRIC_COMMANDS_WRITTEN);
+		if (source_us != 0)
+		{
+			latency_us = time_realtime_us() - source_us;
+			metrics_observe_latency(metrics, (latency_us > 0) ? (uint64_t) latency_us : 0);
+		}
+	}
+	else
+		metrics_count(metrics, METRIC_WRITE_FAILURES);
+	metrics_set(metrics, METRIC_PAN_POSITION, servo_control.pan);
+	metrics_set(metrics, METRIC_TILT_POSITION, servo_control.tilt);
+}
+
+//-------------------------------------------------------------------
+// Hand a new pan/tilt command to the output stage: written at once
+// when unshaped, otherwise it becomes the trajectory target.
+//-------------------------------------------------------------------
+static void command_servo(struct ServoOutput *output, ServoControlDataWriter *servo_writer, ServoControl &servo_control,
+		struct TrackerMetrics *metrics, int32_t pan_position, int32_t tilt_position, int64_t source_us)
+{
+	if (output->shaped)
+	{
+		trajectory_set_target(&output->pan, pan_position);
+		trajectory_set_target(&output->tilt, tilt_position);
+		if (source_us != 0)
+			output->pending_source_us = source_us;
+		return;
+	}
+
+	servo_control.pan = (unsigned short) pan_position;
+	servo_control.tilt = (unsigned short) tilt_position;
+	write_servo_command(servo_writer, servo_control, metrics, source_us, output->stamped);
+}
+
+//-------------------------------------------------------------------
+// One servo tick of the trajectory; only changed positions are
+// written.  Latency is charged to the first tick after an observation.
+//-------------------------------------------------------------------
+static void servo_output_tick(struct ServoOutput *output, ServoControlDataWriter *servo_writer, ServoControl &servo_control,
+		struct TrackerMetrics *metrics)
+{
+	int32_t pan_position = trajectory_step(&output->pan);
+	int32_t tilt_position = trajectory_step(&output->tilt);
+
+	if ((pan_position == servo_control.pan) && (tilt_position == servo_control.tilt) && (output->pending_source_us == 0))
+		return;
+
+	servo_control.pan = (unsigned short) pan_position;
+	servo_control.tilt = (unsigned short) tilt_position;
+	write_servo_command(servo_writer, servo_control, metrics, output->pending_source_us, output->stamped);
+	output->pending_source_us = 0;
+}
+
 //-------------------------------------------------------------------
 // Shutdown in an orderly fashion
 //-------------------------------------------------------------------
@@ -302,7 +435,7 @@ static int subscriber_shutdown (DDSDomainParticipant *participant)
 
 }
 
-int track (int domainId, unsigned int tracked_channel)
+int track (int domainId, const struct TrackerConfig *config)
 {
 	int status = 0;
 	DDSDomainParticipant *participant = NULL;
@@ -313,22 +446,90 @@ int track (int domainId, unsigned int tracked_channel)
 	DDSDataReader *reader = NULL;
 	DDSDataWriter *writer = NULL;
 	DDS_ReturnCode_t retcode;
-	ShapeTypeListener *shape_listener = new ShapeTypeListener;
-	ServoTypeListener *servo_listener = new ServoTypeListener;
+	ShapeTypeListener *shape_listener = NULL;
+	ServoTypeListener *servo_listener = NULL;
+	struct TrackerMetrics *metrics = NULL;
+	struct StatusPublisher *status_publisher = NULL;
+	struct ControlCore core;
+	struct Gimbal &pan  = core.head.axis[GIMBAL_PAN];
+	struct Gimbal &tilt = core.head.axis[GIMBAL_TILT];
+	int64_t now_us;
+	const int64_t servo_period_us = 1000000 / config->servo_hz;
+	struct ServoOutput output;
+	struct SearchPattern *search_pattern = NULL;
+	enum ControlResult result;
+	unsigned int events;
+	struct TargetTable candidates;
+	struct TargetKey publication_key;
+	struct TargetKey source_key = { 0, 0 };
+	bool apply_sample;
+	struct CalibrationSweep *sweep = NULL;
+	bool sweeping = false;
+	int32_t sweep_pan;
+	int32_t sweep_tilt;
+	unsigned int tracked_channel = config->tracked_channel;
+	char metrics_label[METRICS_LABEL_LEN];
 	const char *shape_type_name = NULL;
 	const char *servo_type_name = NULL;
-	ShapeTypeExtended shape;
+	struct ShapePool shape_pool;
+	ShapeTypeExtended *shape = NULL;
 	DDS_SampleInfo shape_info;
 	ServoControl servo_control;
-	DDS_InstanceHandle_t servo_handle = DDS_HANDLE_NIL;
-	int pan_error;
-	int tilt_error;
+	const int32_t *error = core.error;
+	int64_t source_us = 0;
+	int64_t sequence;
 	int frame_count = 0;
-	char channel_filter[50];
+	char channel_filter[80];
+	struct RoiFilter roi;
+	DDS_StringSeq roi_params;
+	DDS_ReturnCode_t roi_retcode;
+	DDS_DataReaderProtocolStatus protocol_status;
+	int64_t loop_start_us;
+	double loop_seconds;
+	bool alloc_armed = false;
+	struct AllocReport alloc_report;
+	bool profiling = false;
+	FILE *record = NULL;
+	struct StageReport stage_report;
+	char profile_label[32];
+
+	control_init(&core, config->servo_hz, config->coast_timeout_us, config->lost_timeout_us, config->gate_sigmas);
+	pan.derivative_period_us  = tilt.derivative_period_us = config->derivative_period_us;
+	pan.derivative_filter_us  = tilt.derivative_filter_us = config->derivative_filter_us;
+	pan.dead_band             = tilt.dead_band            = config->dead_band;
+	pan.dead_band_exit        = tilt.dead_band_exit       = config->dead_band_exit;
+	pan.law                   = tilt.law                  = config->law;
+
+	// Image-to-error tables; linear unless a calibration is given
+	calibration_identity(&core.calibration, PIXY_X_CENTER, PIXY_Y_CENTER);
+	if ((config->calibration_path != NULL) && (calibration_load(&core.calibration, config->calibration_path) != 0))
+		return -1;
+	if (config->calibrate_path != NULL)
+	{
+		sweep = (struct CalibrationSweep *) malloc(sizeof(*sweep));
+		if (sweep == NULL)
+		{
+			fprintf(stderr, "calibration sweep allocation error\n");
+			return -1;
+		}
+		calibration_sweep_init(sweep);
+		printf("Calibration: center a stationary %s ball\n", sigName[tracked_channel]);
+	}
+
+	// Register this tracker's counters before any listener can fire
+	snprintf(metrics_label, sizeof(metrics_label), "domain=\"%d\",color=\"%s\"", domainId, sigName[tracked_channel]);
+	metrics = metrics_register(metrics_label);
+	if (metrics == NULL)
+	{
+		fprintf(stderr, "metrics register error\n");
+		return -1;
+	}
+	core.head.label = metrics->label;
+	shape_listener = new ShapeTypeListener(metrics);
+	servo_listener = new ServoTypeListener(metrics);
 
 	// Create the domain participant
-	participant = DDSTheParticipantFactory->create_participant_with_profile(domainId, "PixyTracker_Library", "PixyTracker_Active_Profile",
-			NULL, DDS_STATUS_MASK_NONE);
+	participant = transport_create_participant(domainId, TRACKER_QOS_LIBRARY, config->qos_profile, config->transport);
 //	participant = DDSTheParticipantFactory->create_participant(0, DDS_PARTICIPANT_QOS_DEFAULT,NULL,DDS_STATUS_MASK_NONE);
 	if (participant == NULL) {
 		fprintf(stderr, "create participant error\n");
@@ -361,10 +562,26 @@ int track (int domainId, unsigned int tracked_channel)
 	DDSContentFilteredTopic *cft = NULL;
     const DDS_StringSeq noFilterParams;
 
+	// -roi also bounds x and y, starting with the whole frame.  The
+	// parameter strings are allocated once and rewritten in place.
+	if (config->roi_margin > 0)
+	{
+		roi_filter_init(&roi, config->roi_margin);
+		roi_params.ensure_length(5, 5);
+		for (int p = 0; p < roi_params.length(); p++)
+			roi_params[p] = DDS_String_alloc(ROI_PARAM_LEN);
+		snprintf(roi_params[0], ROI_PARAM_LEN, "'%s'", sigName[tracked_channel]);
+		roi_format_params(roi_params, &roi.window);
+	}
+
 	if (shape_topic)
 	{
-		sprintf(channel_filter, "color MATCH '%s'", sigName[tracked_channel]);
-		cft = participant->create_contentfilteredtopic("TrackedShape", shape_topic, channel_filter, noFilterParams);
+		if (config->roi_margin > 0)
+			sprintf(channel_filter, "color MATCH %%0 AND x BETWEEN %%1 AND %%2 AND y BETWEEN %%3 AND %%4");
+		else
+			sprintf(channel_filter, "color MATCH '%s'", sigName[tracked_channel]);
+		cft = participant->create_contentfilteredtopic("TrackedShape", shape_topic, channel_filter,
+				(config->roi_margin > 0) ? roi_params : noFilterParams);
 		if (cft == NULL)
 		{
 	        fprintf(stderr, "create content filtered topic\n");
@@ -374,8 +591,9 @@ int track (int domainId, unsigned int tracked_channel)
 	}
 
 	// Create a data reader and a data writer
-	reader = participant->create_datareader_with_profile(cft, "PixyTracker_Library", "PixyTracker_Active_Profile", shape_listener, DDS_STATUS_MASK_ALL);
-	writer = participant->create_datawriter_with_profile(servo_topic, "PixyTracker_Library", "PixyTracker_Active_Profile", servo_listener, DDS_STATUS_MASK_ALL);
+	reader = transport_create_datareader(participant, cft, TRACKER_QOS_LIBRARY, config->qos_profile, config->transport,
+			shape_listener, DDS_STATUS_MASK_ALL);
+	writer = participant->create_datawriter_with_profile(servo_topic, TRACKER_QOS_LIBRARY, config->qos_profile, servo_listener, DDS_STATUS_MASK_ALL);
 	if ((reader == NULL) || (writer == NULL))
 	{
         fprintf(stderr, "create reader and writer\n");
@@ -393,59 +611,667 @@ int track (int domainId, unsigned int tracked_channel)
         return -1;
 	}
 
+	// Fleet status goes out on its own thread; 0 turns it off
+	if (config->status_period_ms > 0)
+	{
+		status_publisher = status_publisher_create(participant, metrics, domainId, sigName[tracked_channel], config->status_period_ms);
+		if (status_publisher == NULL)
+		{
+			subscriber_shutdown(participant);
+			return -1;
+		}
+	}
+
 	ServoControl_initialize(&servo_control);
 	servo_control.pan = PIXY_RCS_CENTER_POS;
 	servo_control.tilt = PIXY_RCS_CENTER_POS;
-	servo_control.frequency = SERVO_FREQUENCY_HZ;
+	servo_control.frequency = config->servo_hz;
+
+	output.shaped = (config->trajectory_mode != TRAJECTORY_OFF);
+	output.stamped = config->stamp_commands;
+	output.next_tick_us = 0;
+	output.pending_source_us = 0;
+	trajectory_init(&output.pan, config->trajectory_mode, pan.position, PIXY_RCS_MIN_POS, PIXY_RCS_MAX_POS,
+			config->servo_hz, TRAJ_MAX_VELOCITY, TRAJ_MAX_ACCEL, TRAJ_MAX_JERK);
+	trajectory_init(&output.tilt, config->trajectory_mode, tilt.position, PIXY_RCS_MIN_POS, PIXY_RCS_MAX_POS,
+			config->servo_hz, TRAJ_MAX_VELOCITY, TRAJ_MAX_ACCEL, TRAJ_MAX_JERK);
+
+	// Scan tables are built once here so scanning is a table read per tick
+	search_pattern = (struct SearchPattern *) malloc(sizeof(*search_pattern));
+	if (search_pattern == NULL)
+	{
+		fprintf(stderr, "search pattern allocation error\n");
+		status_publisher_stop(status_publisher);
+		subscriber_shutdown(participant);
+		status_publisher_delete(status_publisher);
+		return -1;
+	}
+	if (search_pattern_build(search_pattern, config->search_kind, PIXY_RCS_MIN_POS, PIXY_RCS_MAX_POS) != 0)
+	{
+		free(search_pattern);
+		status_publisher_stop(status_publisher);
+		subscriber_shutdown(participant);
+		status_publisher_delete(status_publisher);
+		return -1;
+	}
+	if (config->search_kind != SEARCH_NONE)
+		core.search_pattern = search_pattern;
+
+	// The take buffer comes from the pool so its color storage is never reallocated
+	shape_pool_init(&shape_pool);
+	shape = shape_pool_acquire(&shape_pool);
+	metrics_set(metrics, METRIC_SAMPLE_POOL_HIGH_WATER, shape_pool.high_water);
+	metrics_set(metrics, METRIC_TARGET_STATE, TARGET_LOST);
+	target_table_init(&candidates, config->target_policy, PIXY_X_CENTER, PIXY_Y_CENTER, config->coast_timeout_us);
+
+	// Counters follow this thread only, so each domain gets its own breakdown
+	if (config->profile)
+	{
+		profiling = (stage_profile_open() == 0);
+		if (!profiling)
+			fprintf(stderr, "domain %d: stage profile unavailable: %s\n", domainId, strerror(errno));
+	}
 
-	ShapeTypeExtended_initialize(&shape);
+	if (config->record_path != NULL)
+	{
+		record = replay_record_open(config->record_path);
+		if (record == NULL)
+			fprintf(stderr, "domain %d: not recording observations\n", domainId);
+	}
 
-	while (run_flag == true)
+	loop_start_us = time_monotonic_us();
+	while (__atomic_load_n(&run_flag, __ATOMIC_RELAXED))
 	{
+		metrics_count(metrics, METRIC_LOOP_ITERATIONS);
+		now_us = time_monotonic_us();
+
+		// Fixed-rate servo output, independent of when samples arrive
+		if (output.shaped && (now_us >= output.next_tick_us))
+		{
+			servo_output_tick(&output, servo_writer, servo_control, metrics);
+			output.next_tick_us = (now_us - output.next_tick_us < servo_period_us) ? output.next_tick_us + servo_period_us
+					: now_us + servo_period_us;
+		}
+
+		if (shape_listener->take_deadline_missed())
+		{
+			metrics_count(metrics, METRIC_DEADLINE_MISSES);
+			target_signal_loss(&core.target, now_us);
+		}
+
 		// Get the latest sample
-		retcode = track_reader->take_next_sample(shape, shape_info);
+		stage_profile_begin();
+		retcode = track_reader->take_next_sample(*shape, shape_info);
+		stage_profile_end((retcode == DDS_RETCODE_OK) ? PROFILE_INGEST : PROFILE_POLL);
 
-		if ((retcode == DDS_RETCODE_OK) && (shape_info.valid_data == RTI_TRUE))
+		apply_sample = false;
+		if (retcode == DDS_RETCODE_OK)
 		{
-			// Control the pan & tilt
-			pan_error = PIXY_X_CENTER - shape.x;
-			tilt_error = shape.y - PIXY_Y_CENTER;
-			gimbal_update(&pan, pan_error);
-			gimbal_update(&tilt, tilt_error);
+			metrics_count(metrics, METRIC_SAMPLES_RECEIVED);
+			target_key_from_handle(&publication_key, shape_info.publication_handle);
+			if (shape_info.valid_data != RTI_TRUE)
+			{
+				metrics_count(metrics, METRIC_SAMPLES_FILTERED);
+				// Disposed or no writers left - the Shapes demo does
+				// this when the ball is deleted or the app exits
+				if (shape_info.instance_state == DDS_NOT_ALIVE_DISPOSED_INSTANCE_STATE)
+					target_table_remove(&candidates, &publication_key);
+				else if (shape_info.instance_state == DDS_NOT_ALIVE_NO_WRITERS_INSTANCE_STATE)
+					target_table_clear(&candidates);
+				if (target_table_select(&candidates, now_us) == TARGET_NONE)
+					target_signal_loss(&core.target, now_us);
+			}
+			else
+			{
+				// A reliable backlog flush or a reordering network can hand
+				// us data older than what the gimbal already acted on
+				source_us = DDS_TIME_TO_US(shape_info.source_timestamp);
+				sequence = ((int64_t) shape_info.publication_sequence_number.high << 32)
+						| shape_info.publication_sequence_number.low;
+				TRACKER_PROBE6(sample, metrics->label, shape->x, shape->y, shape->shapesize, source_us,
+						DDS_TIME_TO_US(shape_info.reception_timestamp));
+				if (target_table_order(&candidates, &publication_key, source_us, sequence) != TARGET_ORDER_OK)
+				{
+					metrics_count(metrics, METRIC_SAMPLES_OUT_OF_ORDER);
+					TRACKER_PROBE3(reject, metrics->label, TRACKER_PROBE_REJECT_OUT_OF_ORDER, source_us);
+				}
+				else if ((config->max_age_us > 0) && (time_realtime_us() - source_us > config->max_age_us))
+				{
+					metrics_count(metrics, METRIC_SAMPLES_STALE);
+					TRACKER_PROBE3(reject, metrics->label, TRACKER_PROBE_REJECT_STALE, source_us);
+				}
+				else
+				{
+					// Every publisher of this color writes the same instance;
+					// only the selected publication drives the gimbal
+					int slot = target_table_observe(&candidates, &publication_key, shape->x, shape->y, shape->shapesize,
+							now_us, source_us, sequence);
+					apply_sample = (target_table_select(&candidates, now_us) == slot);
+					if (!apply_sample)
+						metrics_count(metrics, METRIC_SAMPLES_UNSELECTED);
+					metrics_set(metrics, METRIC_CANDIDATES, target_table_count(&candidates));
+				}
+			}
+		}
 
-			servo_control.pan = (unsigned short) pan.position;
-			servo_control.tilt = (unsigned short) tilt.position;
-			servo_writer->write(servo_control, servo_handle);
+		if (apply_sample)
+		{
+			// The error was measured where the camera actually points,
+			// which lags the controller's last target while shaping
+			if (output.shaped)
+			{
+				pan.position  = trajectory_position(&output.pan);
+				tilt.position = trajectory_position(&output.tilt);
+			}
+
+			// Recorded ahead of the gate, which -replay applies again
+			if ((record != NULL) && !sweeping)
+				replay_record(record, source_us, shape->x, shape->y);
+
+			// The sweep moves the camera on purpose, so it is not gated
+			// and does not drive the gimbal
+			if (sweeping)
+				control_measure(&core, shape->x, shape->y, now_us, false);
+			else
+			{
+				// Source timestamps are only comparable within one publication
+				if (!target_key_equal(&publication_key, &source_key))
+				{
+					source_key = publication_key;
+					core.last_source_us = 0;
+				}
+				stage_profile_begin();
+				result = control_observe(&core, shape->x, shape->y, source_us, now_us);
+				stage_profile_end(PROFILE_CONTROL);
+				if (result == CONTROL_GATED)
+				{
+					apply_sample = false;
+					metrics_count(metrics, METRIC_SAMPLES_GATED);
+					TRACKER_PROBE3(reject, metrics->label, TRACKER_PROBE_REJECT_GATED, source_us);
+				}
+			}
+		}
+
+		if (apply_sample && !sweeping)
+		{
+			TRACKER_PROBE6(control, metrics->label, error[GIMBAL_PAN], error[GIMBAL_TILT], pan.position, tilt.position, source_us);
+			metrics_count(metrics, METRIC_CONTROL_UPDATES);
+			if (config->alloc_check && !alloc_armed && (metrics_counter(metrics, METRIC_CONTROL_UPDATES) >= ALLOC_CHECK_WARMUP_UPDATES))
+			{
+				printf("\nAlloc check: warmed up, counting heap allocations\n");
+				alloc_check_arm();
+				alloc_check_set_warm();
+				alloc_armed = true;
+			}
+			metrics_add(metrics, METRIC_ERROR_SQUARED_SUM,
+					(uint64_t) (error[GIMBAL_PAN] * error[GIMBAL_PAN] + error[GIMBAL_TILT] * error[GIMBAL_TILT]));
+
+			// Both axes in their dead band: the command would repeat the last one
+			if (result == CONTROL_HELD)
+				metrics_count(metrics, METRIC_WRITES_HELD);
+			else
+				command_servo(&output, servo_writer, servo_control, metrics, pan.position, tilt.position, source_us);
 
 			if (frame_count++ > 10)
 			{
 				frame_count = 0;
-				printf("P: %d T: %d   \r", pan.position, tilt.position);
+				printf("D: %d P: %d T: %d   \r", domainId, pan.position, tilt.position);
 				fflush(stdout);
 				}
+
+			if ((sweep != NULL) && calibration_sweep_centered(sweep, error[GIMBAL_PAN], error[GIMBAL_TILT], pan.position, tilt.position, now_us))
+			{
+				printf("\nCalibration: centered at P: %d T: %d, sweeping\n", pan.position, tilt.position);
+				sweeping = true;
+			}
+		}
+
+		// Keep the Circle filter around the target.  Parameter changes
+		// are rate bounded discovery traffic, not control, so they sit
+		// outside the allocation check like the calibration save.
+		if ((config->roi_margin > 0) && (apply_sample || sweeping || (core.target.state != TARGET_TRACKING))
+				&& roi_follow(&roi, roi_params, &core.target, sweeping || (core.target.state != TARGET_TRACKING),
+						output.shaped ? trajectory_position(&output.pan)  : pan.position,
+						output.shaped ? trajectory_position(&output.tilt) : tilt.position, now_us))
+		{
+			if (alloc_armed) alloc_check_disarm();
+			roi_retcode = cft->set_expression_parameters(roi_params);
+			if (alloc_armed) alloc_check_arm();
+			if (roi_retcode == DDS_RETCODE_OK)
+				metrics_count(metrics, METRIC_ROI_UPDATES);
+			else
+				fprintf(stderr, "domain %d: ROI filter update error %d\n", domainId, roi_retcode);
+		}
+
+		// Calibration sweep drives the servos directly until both axes are fitted
+		if (sweeping)
+		{
+			if (calibration_sweep_update(sweep, apply_sample, shape->x, shape->y, now_us, &sweep_pan, &sweep_tilt,
+					PAN_SERVO_PER_PIXEL_Q10, TILT_SERVO_PER_PIXEL_Q10))
+			{
+				pan.position = sweep_pan;
+				tilt.position = sweep_tilt;
+				control_clear_error(&core);
+				command_servo(&output, servo_writer, servo_control, metrics, pan.position, tilt.position, 0);
+			}
+			if (sweep->phase == CAL_DONE)
+			{
+				// Saving is file I/O, not part of the steady-state loop
+				if (alloc_armed) alloc_check_disarm();
+				if (!sweep->failed && (calibration_save(&sweep->result, config->calibrate_path) == 0))
+				{
+					core.calibration = sweep->result;
+					printf("Calibration: saved %s\n", config->calibrate_path);
+				}
+				if (alloc_armed) alloc_check_arm();
+				sweeping = false;
+			}
+			continue;
 		}
+
+		// Target timeouts, and the coast or search step when one is due
+		events = control_tick(&core, now_us);
+		if (events & CONTROL_TICK_STATE)
+		{
+			printf("\nTarget %s\n", target_state_name(core.state));
+			metrics_set(metrics, METRIC_TARGET_STATE, core.state);
+			if (core.state == TARGET_LOST)
+				metrics_count(metrics, METRIC_TARGETS_LOST);
+		}
+		if (events & CONTROL_TICK_REACQUIRED)
+		{
+			metrics_count(metrics, METRIC_REACQUISITIONS);
+			metrics_set(metrics, METRIC_REACQUIRE_MS, (now_us - core.search_start_us) / 1000);
+			printf("Reacquired after %lld ms\n", (long long) ((now_us - core.search_start_us) / 1000));
+		}
+		if (events & CONTROL_TICK_WRITE)
+			command_servo(&output, servo_writer, servo_control, metrics, pan.position, tilt.position, 0);
 	}
+	if (alloc_armed)
+		alloc_check_disarm();
+
+	// What the Circle reader took off the wire, to compare runs with
+	// and without -roi; reader-side filtered samples are included
+	loop_seconds = (double) (time_monotonic_us() - loop_start_us) / 1e6;
+	if (track_reader->get_datareader_protocol_status(protocol_status) == DDS_RETCODE_OK)
+		printf("\ndomain %d: Circle received %lld samples, %lld bytes in %.1f s (%.0f bytes/s), %llu ROI updates\n",
+				domainId, (long long) protocol_status.received_sample_count, (long long) protocol_status.received_sample_bytes,
+				loop_seconds, (double) protocol_status.received_sample_bytes / loop_seconds,
+				(unsigned long long) metrics_counter(metrics, METRIC_ROI_UPDATES));
+	status_publisher_stop(status_publisher);
 	status = subscriber_shutdown(participant);
+	status_publisher_delete(status_publisher);
+	shape_pool_release(&shape_pool, shape);
+	replay_record_close(record);
+	free(search_pattern);
+	free(sweep);
+
+	if (profiling)
+	{
+		stage_profile_report(&stage_report);
+		stage_profile_close();
+		snprintf(profile_label, sizeof(profile_label), "domain %d", domainId);
+		stage_profile_print(&stage_report, profile_label);
+	}
+
+	if (config->alloc_check)
+	{
+		alloc_check_report(&alloc_report);
+		if (!alloc_armed)
+		{
+			printf("\nAlloc check: FAILED, only %llu control updates, warm-up needs %d\n",
+					(unsigned long long) metrics_counter(metrics, METRIC_CONTROL_UPDATES), ALLOC_CHECK_WARMUP_UPDATES);
+			status = -1;
+		}
+		else if (alloc_report.count > 0)
+		{
+			printf("\nAlloc check: FAILED, %llu allocations (%llu bytes) after warm-up\n",
+					(unsigned long long) alloc_report.count, (unsigned long long) alloc_report.bytes);
+			for (int c = 0; c < alloc_report.callers; c++)
+				printf("  %lu bytes from %p\n", (unsigned long) alloc_report.size[c], alloc_report.caller[c]);
+			status = -1;
+		}
+		else
+			printf("\nAlloc check: passed, no allocations after warm-up\n");
+	}
 	return status;
 }
+static void *domain_tracker_main(void *arg)
+{
+	struct DomainTracker *domain = (struct DomainTracker *) arg;
+
+	domain->result = track(domain->domain_id, domain->config);
+	if (domain->result != 0)
+		fprintf(stderr, "domain %d tracker exited with %d\n", domain->domain_id, domain->result);
+
+	return NULL;
+}
+
 //-------------------------------------------------------------------
 // Program entry point
 //-------------------------------------------------------------------
 int main (int argc, char *argv[])
 {
-    int domainId = 53;
-    int return_value;
+    struct DomainTracker domains[TRACKER_MAX_DOMAINS];
+    int domainCount = 0;
+    int started = 0;
+    int return_value = 0;
     unsigned int trackedChannel = INDEX_GREEN;
+    const char *metricsFile = NULL;
+    const char *metricsSocket = NULL;
+    const char *qosBench = NULL;
+    const char *benchTransports = NULL;
+    const char *replaySource = NULL;
+    const char *replayOut = NULL;
+    const char *replayGolden = NULL;
+    int replayCompare = -1;
+    struct ReplaySettings replay;
+    int sweepMaxHz = 0;
+    int demuxPublishers = 0;
+    struct TrackerConfig config;
+
+    config.status_period_ms = STATUS_PERIOD_MS;
+    config.coast_timeout_us = TARGET_COAST_TIMEOUT_US;
+    config.lost_timeout_us  = TARGET_LOST_TIMEOUT_US;
+    config.search_kind      = SEARCH_SPIRAL;
+    config.target_policy    = TARGET_POLICY_NEAREST;
+    config.calibration_path = NULL;
+    config.calibrate_path   = NULL;
+    config.trajectory_mode  = TRAJECTORY_OFF;
+    config.servo_hz         = SERVO_FREQUENCY_HZ;
+    config.alloc_check      = false;
+    config.profile          = false;
+    config.record_path      = NULL;
+    config.stamp_commands   = false;
+    config.qos_profile      = TRACKER_QOS_PROFILE;
+    config.transport        = TRANSPORT_UDP;
+    config.derivative_period_us = 0;
+    config.derivative_filter_us = 0;
+    config.max_age_us       = 0;
+    config.roi_margin       = 0;
+    config.gate_sigmas      = 0;
+    config.dead_band        = 0;
+    config.dead_band_exit   = 0;
+    config.law              = GIMBAL_LAW_PD;
+
+    // -bench <name> runs an offline benchmark instead of tracking
+    if ((argc > 2) && (strcmp(argv[1], "-bench") == 0))
+        return bench_run(argv[2]);
 
     signal(SIGINT, handle_SIGINT);
 
     printf("PIXY TRACKER: %s %s\n", __DATE__, __TIME__);
-    printf("DomainID: %d\n", domainId);
-
     if (argc > 1)
     {
         for (int count = 1; count < argc; count++)
         {
+            // -domain <id> joins a domain; repeat it to track in several
+            if ((strcmp(argv[count], "-domain") == 0) && (count + 1 < argc))
+            {
+                if (domainCount == TRACKER_MAX_DOMAINS)
+                {
+                    fprintf(stderr, "at most %d domains\n", TRACKER_MAX_DOMAINS);
+                    return -1;
+                }
+                domains[domainCount++].domain_id = atoi(argv[++count]);
+                continue;
+            }
+            // -metrics-file <path> / -metrics-socket <path> expose Prometheus text
+            if ((strcmp(argv[count], "-metrics-file") == 0) && (count + 1 < argc))
+            {
+                metricsFile = argv[++count];
+                continue;
+            }
+            if ((strcmp(argv[count], "-metrics-socket") == 0) && (count + 1 < argc))
+            {
+                metricsSocket = argv[++count];
+                continue;
+            }
+            // -status-period <ms> sets the TrackerStatus rate, 0 disables it
+            if ((strcmp(argv[count], "-status-period") == 0) && (count + 1 < argc))
+            {
+                config.status_period_ms = (unsigned int) atoi(argv[++count]);
+                continue;
+            }
+            // -coast-ms <ms> / -lost-ms <ms> set the target-loss timeouts
+            if ((strcmp(argv[count], "-coast-ms") == 0) && (count + 1 < argc))
+            {
+                config.coast_timeout_us = (int64_t) atoi(argv[++count]) * 1000;
+                continue;
+            }
+            if ((strcmp(argv[count], "-lost-ms") == 0) && (count + 1 < argc))
+            {
+                config.lost_timeout_us = (int64_t) atoi(argv[++count]) * 1000;
+                continue;
+            }
+            // -search raster|spiral|heading|none picks the lost-target scan
+            if ((strcmp(argv[count], "-search") == 0) && (count + 1 < argc))
+            {
+                int kind = search_pattern_parse(argv[++count]);
+                if (kind < 0)
+                {
+                    fprintf(stderr, "unknown search pattern %s\n", argv[count]);
+                    return -1;
+                }
+                config.search_kind = (enum SearchPatternKind) kind;
+                continue;
+            }
+            // -select nearest|largest|sticky picks between same-colored publishers
+            if ((strcmp(argv[count], "-select") == 0) && (count + 1 < argc))
+            {
+                int policy = target_policy_parse(argv[++count]);
+                if (policy < 0)
+                {
+                    fprintf(stderr, "unknown selection policy %s\n", argv[count]);
+                    return -1;
+                }
+                config.target_policy = (enum TargetPolicy) policy;
+                continue;
+            }
+            // -calibration <file> loads an image-to-error table;
+            // -calibrate <file> measures one and saves it
+            if ((strcmp(argv[count], "-calibration") == 0) && (count + 1 < argc))
+            {
+                config.calibration_path = argv[++count];
+                continue;
+            }
+            if ((strcmp(argv[count], "-calibrate") == 0) && (count + 1 < argc))
+            {
+                config.calibrate_path = argv[++count];
+                continue;
+            }
+            // -record <file> saves the applied observations for -replay
+            if ((strcmp(argv[count], "-record") == 0) && (count + 1 < argc))
+            {
+                config.record_path = argv[++count];
+                continue;
+            }
+            // -replay <file>|synthetic[:count[:seed]] runs them through the
+            // controller offline; -replay-out / -replay-golden write / compare.
+            // -replay search[:trials[:seed]] times reacquisition per -search pattern
+            if ((strcmp(argv[count], "-replay") == 0) && (count + 1 < argc))
+            {
+                replaySource = argv[++count];
+                continue;
+            }
+            if ((strcmp(argv[count], "-replay-out") == 0) && (count + 1 < argc))
+            {
+                replayOut = argv[++count];
+                continue;
+            }
+            if ((strcmp(argv[count], "-replay-golden") == 0) && (count + 1 < argc))
+            {
+                replayGolden = argv[++count];
+                continue;
+            }
+            // -replay-compare <law> also replays with another law and
+            // reports its cost and how far its commands are
+            if ((strcmp(argv[count], "-replay-compare") == 0) && (count + 1 < argc))
+            {
+                replayCompare = gimbal_law_parse(argv[++count]);
+                if (replayCompare < 0)
+                {
+                    fprintf(stderr, "unknown law %s: p pd pid pid-aw, or any of them with -float\n", argv[count]);
+                    return -1;
+                }
+                continue;
+            }
+            // -trajectory off|accel|jerk shapes commands at the servo rate;
+            // -servo-hz <n> sets that rate (ServoControl.frequency)
+            if ((strcmp(argv[count], "-trajectory") == 0) && (count + 1 < argc))
+            {
+                int mode = trajectory_mode_parse(argv[++count]);
+                if (mode < 0)
+                {
+                    fprintf(stderr, "unknown trajectory mode %s\n", argv[count]);
+                    return -1;
+                }
+                config.trajectory_mode = (enum TrajectoryMode) mode;
+                continue;
+            }
+            if ((strcmp(argv[count], "-servo-hz") == 0) && (count + 1 < argc))
+            {
+                int hz = atoi(argv[++count]);
+                if ((hz <= 0) || (hz > 1000))
+                {
+                    fprintf(stderr, "servo rate %s out of range (1..1000)\n", argv[count]);
+                    return -1;
+                }
+                config.servo_hz = (unsigned int) hz;
+                continue;
+            }
+            // -qos <name> picks the reader/writer/participant profile;
+            // -qos-bench <name,...|all> measures them instead of tracking
+            if ((strcmp(argv[count], "-qos") == 0) && (count + 1 < argc))
+            {
+                config.qos_profile = tracker_qos_profile(argv[++count]);
+                continue;
+            }
+            if ((strcmp(argv[count], "-qos-bench") == 0) && (count + 1 < argc))
+            {
+                qosBench = argv[++count];
+                continue;
+            }
+            // -d-period <ms> scales the derivative by the real sample
+            // interval (D gain tuned for <ms>); -d-filter <ms> low-passes it
+            if ((strcmp(argv[count], "-d-period") == 0) && (count + 1 < argc))
+            {
+                config.derivative_period_us = atoi(argv[++count]) * 1000;
+                continue;
+            }
+            if ((strcmp(argv[count], "-d-filter") == 0) && (count + 1 < argc))
+            {
+                config.derivative_filter_us = atoi(argv[++count]) * 1000;
+                continue;
+            }
+            // -max-age-ms <ms> drops observations older than this when taken
+            if ((strcmp(argv[count], "-max-age-ms") == 0) && (count + 1 < argc))
+            {
+                config.max_age_us = (int64_t) atoi(argv[++count]) * 1000;
+                continue;
+            }
+            // -roi <pixels> narrows the Circle filter to a window this
+            // far around the predicted target while tracking
+            if ((strcmp(argv[count], "-roi") == 0) && (count + 1 < argc))
+            {
+                config.roi_margin = atoi(argv[++count]);
+                if (config.roi_margin < 0)
+                    config.roi_margin = 0;
+                continue;
+            }
+            // -gate <sigmas> drops observations farther than that from
+            // the predicted target, in units of its residual spread
+            if ((strcmp(argv[count], "-gate") == 0) && (count + 1 < argc))
+            {
+                config.gate_sigmas = atoi(argv[++count]);
+                continue;
+            }
+            // -dead-band <px>[:<exit px>] holds an axis while its error
+            // stays inside the band; it is left beyond the exit (2x)
+            if ((strcmp(argv[count], "-dead-band") == 0) && (count + 1 < argc))
+            {
+                char *end;
+
+                config.dead_band = (int32_t) strtol(argv[++count], &end, 10);
+                config.dead_band_exit = (*end == ':') ? (int32_t) strtol(end + 1, NULL, 10) : 2 * config.dead_band;
+                if (config.dead_band_exit < config.dead_band)
+                    config.dead_band_exit = config.dead_band;
+                continue;
+            }
+            // -law p|pd|pid|pid-aw[-float] picks the controller law for both axes
+            if ((strcmp(argv[count], "-law") == 0) && (count + 1 < argc))
+            {
+                config.law = gimbal_law_parse(argv[++count]);
+                if (config.law < 0)
+                {
+                    fprintf(stderr, "unknown law %s: p pd pid pid-aw, or any of them with -float\n", argv[count]);
+                    return -1;
+                }
+                continue;
+            }
+            // -transport udp|shmem|auto picks the built-in transports;
+            // -qos-bench-transport <name,...> compares them in the bench
+            if ((strcmp(argv[count], "-transport") == 0) && (count + 1 < argc))
+            {
+                int transport = transport_parse(argv[++count]);
+                if (transport < 0)
+                {
+                    fprintf(stderr, "unknown transport %s\n", argv[count]);
+                    return -1;
+                }
+                config.transport = (enum TrackerTransport) transport;
+                continue;
+            }
+            if ((strcmp(argv[count], "-qos-bench-transport") == 0) && (count + 1 < argc))
+            {
+                benchTransports = argv[++count];
+                continue;
+            }
+            // -latency-sweep <max Hz> measures latency against the input rate
+            if ((strcmp(argv[count], "-latency-sweep") == 0) && (count + 1 < argc))
+            {
+                sweepMaxHz = atoi(argv[++count]);
+                if (sweepMaxHz < QOS_SWEEP_START_HZ)
+                {
+                    fprintf(stderr, "-latency-sweep needs at least %d\n", QOS_SWEEP_START_HZ);
+                    return -1;
+                }
+                continue;
+            }
+            // -demux-bench <max publishers> compares filtered readers with ColorDemux
+            if ((strcmp(argv[count], "-demux-bench") == 0) && (count + 1 < argc))
+            {
+                demuxPublishers = atoi(argv[++count]);
+                if ((demuxPublishers < 1) || (demuxPublishers > DEMUX_BENCH_MAX_PUBLISHERS))
+                {
+                    fprintf(stderr, "-demux-bench takes 1..%d publishers\n", DEMUX_BENCH_MAX_PUBLISHERS);
+                    return -1;
+                }
+                continue;
+            }
+            // -alloc-check fails the run if the loop allocates after warm-up
+            if (strcmp(argv[count], "-alloc-check") == 0)
+            {
+                if (alloc_check_enable() != 0)
+                {
+                    fprintf(stderr, "-alloc-check needs a glibc build with TRACKER_ALLOC_CHECK defined\n");
+                    return -1;
+                }
+                config.alloc_check = true;
+                continue;
+            }
+            // -stamp-commands gives each command its observation's source timestamp
+            if (strcmp(argv[count], "-stamp-commands") == 0)
+            {
+                config.stamp_commands = true;
+                continue;
+            }
+            // -profile prints per-stage hardware counters on exit
+            if (strcmp(argv[count], "-profile") == 0)
+            {
+                config.profile = true;
+                continue;
+            }
             for (int sigs = 0; sigs < NUM_SIGS; sigs++)
             {
                 if (strcmp(argv[count], sigName[sigs])== 0)
@@ -457,9 +1283,81 @@ int main (int argc, char *argv[])
         }
     }
 
+    if (replaySource != NULL)
+    {
+        replay.servo_hz = (int32_t) config.servo_hz;
+        replay.coast_timeout_us = (int32_t) config.coast_timeout_us;
+        replay.lost_timeout_us = (int32_t) config.lost_timeout_us;
+        replay.derivative_period_us = config.derivative_period_us;
+        replay.derivative_filter_us = config.derivative_filter_us;
+        replay.dead_band = config.dead_band;
+        replay.dead_band_exit = config.dead_band_exit;
+        replay.law = config.law;
+        replay.gate_sigmas = config.gate_sigmas;
+        replay.compare_law = replayCompare;
+        replay.x_center = PIXY_X_CENTER;
+        replay.y_center = PIXY_Y_CENTER;
+        replay.calibration_path = config.calibration_path;
+        return replay_run(&replay, replaySource, replayOut, replayGolden);
+    }
+
+    if (domainCount == 0)
+        domains[domainCount++].domain_id = DEFAULT_DOMAIN_ID;
+    if (((config.calibrate_path != NULL) || (config.record_path != NULL)) && (domainCount > 1))
+    {
+        fprintf(stderr, "-calibrate and -record follow one camera, give a single -domain\n");
+        return -1;
+    }
+
     if (trackedChannel > NUM_SIGS) trackedChannel = INDEX_GREEN;
+    for (int d = 0; d < domainCount; d++)
+        printf("DomainID: %d\n", domains[d].domain_id);
     printf("Tracking %s\n", sigName[trackedChannel]);
-    initialize_gimbals();
-    track(domainId, trackedChannel);
+    printf("QoS profile: %s, transport %s\n", config.qos_profile, transport_name(config.transport));
+    if (metrics_start_exporter(metricsFile, metricsSocket, METRICS_PERIOD_MS) != 0)
+        return -1;
+    config.tracked_channel = trackedChannel;
+
+    if (qosBench != NULL)
+    {
+        return_value = qos_bench_run(domains[0].domain_id, &config, qosBench,
+                (benchTransports != NULL) ? benchTransports : transport_name(config.transport));
+        metrics_stop_exporter();
+        return return_value;
+    }
+    if (demuxPublishers > 0)
+    {
+        return_value = demux_bench_run(domains[0].domain_id, &config, demuxPublishers);
+        metrics_stop_exporter();
+        return return_value;
+    }
+    if (sweepMaxHz > 0)
+    {
+        return_value = qos_bench_sweep(domains[0].domain_id, &config, sweepMaxHz);
+        metrics_stop_exporter();
+        return return_value;
+    }
+
+    for (started = 0; started < domainCount; started++)
+    {
+        domains[started].config = &config;
+        domains[started].result = 0;
+        if (pthread_create(&domains[started].thread, NULL, domain_tracker_main, &domains[started]) != 0)
+        {
+            fprintf(stderr, "domain %d thread create error\n", domains[started].domain_id);
+            tracker_set_running(false);
+            return_value = -1;
+            break;
+        }
+    }
+    for (int d = 0; d < started; d++)
+    {
+        pthread_join(domains[d].thread, NULL);
+        if (domains[d].result != 0)
+            return_value = domains[d].result;
+    }
+    metrics_stop_exporter();
+
+    return return_value;
 
 }
@@ -0,0 +1,85 @@
+//-------------------------------------------------------------------
+// tracker.h - what the tracker loop needs from its caller
+//
+// main() fills a TrackerConfig from the command line and runs track()
+// once per domain.  Harnesses that drive the real loop (benchmarks)
+// use the same entry point and stop it with tracker_set_running().
+//-------------------------------------------------------------------
+#ifndef TRACKER_H
+#define TRACKER_H
+
+#include <stdint.h>
+#include "search_pattern.h"
+#include "target_table.h"
+#include "trajectory.h"
+#include "transport.h"
+
+#define NUM_SIGS 7
+
+// Shapes demo frame
+#define SHAPE_X_MIN 0
+#define SHAPE_X_MAX 222
+#define SHAPE_Y_MIN 0
+#define SHAPE_Y_MAX 252
+
+#define PIXY_X_CENTER              ((SHAPE_X_MAX-SHAPE_X_MIN)/2)
+#define PIXY_Y_CENTER              ((SHAPE_Y_MAX-SHAPE_Y_MIN)/2)
+
+#define TRACKER_QOS_LIBRARY        "PixyTracker_Library"
+#define TRACKER_QOS_PROFILE        "PixyTracker_Profile"
+
+//-------------------------------------------------------------------
+// Run-time settings collected from the command line
+//-------------------------------------------------------------------
+struct TrackerConfig {
+	unsigned int tracked_channel;
+	unsigned int status_period_ms;
+	int64_t      coast_timeout_us;
+	int64_t      lost_timeout_us;
+	enum SearchPatternKind search_kind;
+	enum TargetPolicy target_policy;
+	const char  *calibration_path;   // table to load, NULL for linear
+	const char  *calibrate_path;     // run the calibration sweep and save here
+	const char  *record_path;        // applied observations for -replay
+	enum TrajectoryMode trajectory_mode;
+	unsigned int servo_hz;           // ServoControl.frequency and output tick rate
+	bool         alloc_check;        // fail if the warmed-up loop touches the heap
+	bool         profile;            // perf_event counters per loop stage, printed on exit
+	bool         stamp_commands;     // ServoControl source timestamp = observation's
+	const char  *qos_profile;        // profile in TRACKER_QOS_LIBRARY for reader, writer and participant
+	enum TrackerTransport transport;
+	int32_t      derivative_period_us; // interval the D gains are tuned for; 0 = per-sample difference
+	int32_t      derivative_filter_us; // D low-pass time constant; 0 = off
+	int64_t      max_age_us;         // reject observations older than this; 0 = no budget
+	int32_t      roi_margin;         // pixels around the predicted target the filter passes; 0 = color only
+	int32_t      gate_sigmas;        // validation gate around the prediction; 0 = off
+	int32_t      dead_band;          // pixels of error that start holding an axis; 0 = off
+	int32_t      dead_band_exit;     // pixels of error that end it
+	int          law;                // enum GimbalLaw for both axes
+};
+
+extern const char *sigName[];
+
+// Runs the control loop on one domain until tracker_set_running(false)
+// or Ctrl-C; returns 0 on an orderly shutdown
+int track (int domainId, const struct TrackerConfig *config);
+
+void tracker_set_running(bool running);
+
+//-------------------------------------------------------------------
+// Curated QoS profiles, selectable with -qos by short name
+//-------------------------------------------------------------------
+struct TrackerQosProfile {
+	const char *name;
+	const char *profile;
+	const char *description;
+};
+
+extern const struct TrackerQosProfile trackerQosProfiles[];
+extern const int trackerQosProfileCount;
+
+// Short name or full profile name; unknown names are passed through
+// so profiles added to the XML can be used without a rebuild
+const char *tracker_qos_profile(const char *name);
+
+#endif
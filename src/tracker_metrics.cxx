@@ -0,0 +1,363 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "tracker_metrics.h"
+#include "tracker_time.h"
+
+#define METRICS_TEXT_SIZE 8192
+
+struct MetricInfo {
+	const char *name;
+	const char *help;
+};
+
+static const struct MetricInfo counterInfo[METRIC_COUNTER_COUNT] = {
+	{ "pixytracker_samples_received_total",  "Circle samples taken from the reader" },
+	{ "pixytracker_samples_filtered_total",  "Samples without valid data (disposed / no writers)" },
+	{ "pixytracker_commands_written_total",  "ServoControl samples written" },
+	{ "pixytracker_write_failures_total",    "ServoControl writes that did not return OK" },
+	{ "pixytracker_loop_iterations_total",   "Passes through the control loop" },
+	{ "pixytracker_control_updates_total",   "Observations applied to the pan/tilt controllers" },
+	{ "pixytracker_error_squared_sum",       "Sum of squared pan+tilt tracking error (pixels^2)" },
+	{ "pixytracker_deadline_misses_total",   "Requested deadline misses on the Circle reader" },
+	{ "pixytracker_targets_lost_total",      "Times the target went from coasting to lost" },
+	{ "pixytracker_reacquisitions_total",    "Lost targets found again by the search scan" },
+	{ "pixytracker_samples_unselected_total", "Samples from same-colored publishers other than the selected one" },
+	{ "pixytracker_samples_out_of_order_total", "Samples older (timestamp or sequence) than one already applied from the same publisher" },
+	{ "pixytracker_samples_stale_total",    "Samples older than the -max-age budget when taken" },
+	{ "pixytracker_roi_updates_total",      "Region-of-interest filter parameter changes" },
+	{ "pixytracker_samples_gated_total",    "Selected samples outside the -gate window around the predicted target" },
+	{ "pixytracker_writes_held_total",      "Observations inside the -dead-band on both axes, so no command was written" }
+};
+
+static const struct MetricInfo gaugeInfo[METRIC_GAUGE_COUNT] = {
+	{ "pixytracker_matched_publishers",  "Circle publishers currently matched" },
+	{ "pixytracker_matched_subscribers", "ServoControl subscribers currently matched" },
+	{ "pixytracker_pan_position",        "Last commanded pan position" },
+	{ "pixytracker_tilt_position",       "Last commanded tilt position" },
+	{ "pixytracker_target_state",        "0 tracking, 1 coasting, 2 lost" },
+	{ "pixytracker_reacquire_ms",        "Search time before the last reacquisition" },
+	{ "pixytracker_candidates",          "Publications currently offering a target of the tracked color" },
+	{ "pixytracker_sample_pool_high_water", "Most ShapeTypeExtended pool samples in use at once" }
+};
+
+static const struct MetricInfo latencyInfo = {
+	"pixytracker_latency_us", "Observation source timestamp to servo command write (microseconds)"
+};
+static const char sumName[]   = "pixytracker_latency_us_sum";
+static const char countName[] = "pixytracker_latency_us_count";
+
+static struct TrackerMetrics registry[METRICS_MAX_INSTANCES];
+static int registered = 0;
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_t exporter_thread;
+static bool exporter_running = false;
+static bool exporter_stop = false;
+static const char *exporter_file = NULL;
+static const char *exporter_socket = NULL;
+static unsigned int exporter_period_ms = 1000;
+static int listen_fd = -1;
+static char exporter_text[METRICS_TEXT_SIZE];
+
+//-------------------------------------------------------------------
+// metrics_register - hand out the next free block in the registry
+//-------------------------------------------------------------------
+struct TrackerMetrics *metrics_register(const char *label)
+{
+	struct TrackerMetrics *m = NULL;
+
+	pthread_mutex_lock(&registry_lock);
+	if (registered < METRICS_MAX_INSTANCES)
+	{
+		m = &registry[registered];
+		memset(m, 0, sizeof(*m));
+		snprintf(m->label, sizeof(m->label), "%s", label ? label : "");
+		registered++;
+	}
+	pthread_mutex_unlock(&registry_lock);
+
+	return m;
+}
+
+static int format_line(char *buffer, int len, int used, const char *name, const char *label, long long value)
+{
+	int n;
+
+	if (used >= len) return used;
+	if (label[0] != '\0')
+		n = snprintf(buffer + used, len - used, "%s{%s} %lld\n", name, label, value);
+	else
+		n = snprintf(buffer + used, len - used, "%s %lld\n", name, value);
+
+	return (n < 0) ? used : used + n;
+}
+
+//-------------------------------------------------------------------
+// Prometheus histograms are cumulative; only octave boundaries are
+// exported to keep the text short.
+//-------------------------------------------------------------------
+static int format_histogram(char *buffer, int len, int used, const struct TrackerMetrics *m)
+{
+	uint64_t histogram[METRICS_LATENCY_BUCKETS];
+	uint64_t cumulative = 0;
+	const char *sep = (m->label[0] != '\0') ? "," : "";
+	int n;
+
+	metrics_latency_snapshot(m, histogram);
+	for (int b = 0; b < METRICS_LATENCY_BUCKETS; b++)
+	{
+		cumulative += histogram[b];
+		if ((b < 3) || ((b % 4) != 3) || (b == METRICS_LATENCY_BUCKETS - 1)) continue;
+		if (used >= len) return used;
+		n = snprintf(buffer + used, len - used, "%s_bucket{%s%sle=\"%llu\"} %llu\n", latencyInfo.name,
+				m->label, sep, (unsigned long long) metrics_latency_bucket_limit(b), (unsigned long long) cumulative);
+		if (n > 0) used += n;
+	}
+	if (used >= len) return used;
+	n = snprintf(buffer + used, len - used, "%s_bucket{%s%sle=\"+Inf\"} %llu\n",
+			latencyInfo.name, m->label, sep, (unsigned long long) cumulative);
+	if (n > 0) used += n;
+
+	// The sum is read after the buckets, so it may include a few
+	// observations the counts do not yet; the scrape after catches up
+	used = format_line(buffer, len, used, sumName, m->label, (long long) __atomic_load_n(&m->latency_sum, __ATOMIC_RELAXED));
+	return format_line(buffer, len, used, countName, m->label, (long long) cumulative);
+}
+
+static int format_header(char *buffer, int len, int used, const struct MetricInfo *info, const char *type)
+{
+	int n;
+
+	if (used >= len) return used;
+	n = snprintf(buffer + used, len - used, "# HELP %s %s\n# TYPE %s %s\n", info->name, info->help, info->name, type);
+
+	return (n < 0) ? used : used + n;
+}
+
+//-------------------------------------------------------------------
+// metrics_format - render all registered blocks as Prometheus text
+//-------------------------------------------------------------------
+int metrics_format(char *buffer, int len)
+{
+	int used = 0;
+	int count;
+
+	if (len <= 0) return 0;
+	buffer[0] = '\0';
+
+	pthread_mutex_lock(&registry_lock);
+	count = registered;
+	pthread_mutex_unlock(&registry_lock);
+
+	for (int c = 0; c < METRIC_COUNTER_COUNT; c++)
+	{
+		used = format_header(buffer, len, used, &counterInfo[c], "counter");
+		for (int i = 0; i < count; i++)
+			used = format_line(buffer, len, used, counterInfo[c].name, registry[i].label,
+					(long long) metrics_counter(&registry[i], (enum TrackerCounter) c));
+	}
+	for (int g = 0; g < METRIC_GAUGE_COUNT; g++)
+	{
+		used = format_header(buffer, len, used, &gaugeInfo[g], "gauge");
+		for (int i = 0; i < count; i++)
+			used = format_line(buffer, len, used, gaugeInfo[g].name, registry[i].label,
+					(long long) metrics_gauge(&registry[i], (enum TrackerGauge) g));
+	}
+
+	used = format_header(buffer, len, used, &latencyInfo, "histogram");
+	for (int i = 0; i < count; i++)
+		used = format_histogram(buffer, len, used, &registry[i]);
+
+	return (used < len) ? used : len - 1;
+}
+
+void metrics_latency_snapshot(const struct TrackerMetrics *m, uint64_t histogram[METRICS_LATENCY_BUCKETS])
+{
+	for (int b = 0; b < METRICS_LATENCY_BUCKETS; b++)
+		histogram[b] = __atomic_load_n(&m->latency[b], __ATOMIC_RELAXED);
+}
+
+uint64_t metrics_latency_quantile(const uint64_t histogram[METRICS_LATENCY_BUCKETS], double q)
+{
+	uint64_t total = 0;
+	uint64_t rank;
+	uint64_t seen = 0;
+
+	for (int b = 0; b < METRICS_LATENCY_BUCKETS; b++)
+		total += histogram[b];
+	if (total == 0) return 0;
+
+	rank = (uint64_t) (q * (double) total);
+	if (rank >= total) rank = total - 1;
+	for (int b = 0; b < METRICS_LATENCY_BUCKETS; b++)
+	{
+		seen += histogram[b];
+		if (seen > rank) return metrics_latency_bucket_limit(b);
+	}
+
+	return metrics_latency_bucket_limit(METRICS_LATENCY_BUCKETS - 1);
+}
+
+static void write_all(int fd, const char *data, int len)
+{
+	while (len > 0)
+	{
+		ssize_t n = write(fd, data, len);
+		if (n < 0)
+		{
+			if (errno == EINTR) continue;
+			return;
+		}
+		data += n;
+		len  -= (int) n;
+	}
+}
+
+//-------------------------------------------------------------------
+// Rewrite the metrics file through a temporary so scrapers never see
+// a partially written snapshot
+//-------------------------------------------------------------------
+static void export_file(void)
+{
+	char tmp_path[512];
+	FILE *fp;
+	int len;
+
+	snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", exporter_file);
+	fp = fopen(tmp_path, "w");
+	if (fp == NULL) return;
+
+	len = metrics_format(exporter_text, sizeof(exporter_text));
+	fwrite(exporter_text, 1, len, fp);
+	fclose(fp);
+	rename(tmp_path, exporter_file);
+}
+
+static int open_socket(const char *path)
+{
+	struct sockaddr_un addr;
+	int fd;
+
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) return -1;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+	unlink(path);
+
+	if ((bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) || (listen(fd, 4) < 0))
+	{
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+//-------------------------------------------------------------------
+// Exporter thread - serves socket scrapes as they arrive and rewrites
+// the file once per period, however many scrapes came in between
+//-------------------------------------------------------------------
+static void *exporter_main(void *unused)
+{
+	struct pollfd pfd;
+	int64_t next_export_us = time_monotonic_us() + (int64_t) exporter_period_ms * 1000;
+	int64_t wait_us;
+
+	while (!__atomic_load_n(&exporter_stop, __ATOMIC_ACQUIRE))
+	{
+		wait_us = next_export_us - time_monotonic_us();
+		if (wait_us < 0) wait_us = 0;
+
+		if (listen_fd >= 0)
+		{
+			pfd.fd = listen_fd;
+			pfd.events = POLLIN;
+			pfd.revents = 0;
+			if ((poll(&pfd, 1, (int) ((wait_us + 999) / 1000)) > 0) && (pfd.revents & POLLIN))
+			{
+				int client = accept(listen_fd, NULL, NULL);
+				if (client >= 0)
+				{
+					int len = metrics_format(exporter_text, sizeof(exporter_text));
+					write_all(client, exporter_text, len);
+					close(client);
+				}
+			}
+		}
+		else
+		{
+			usleep((useconds_t) wait_us);
+		}
+
+		if (time_monotonic_us() >= next_export_us)
+		{
+			if (exporter_file != NULL)
+				export_file();
+			next_export_us += (int64_t) exporter_period_ms * 1000;
+			// After a stall, resume the period from now instead of catching up
+			if (next_export_us <= time_monotonic_us())
+				next_export_us = time_monotonic_us() + (int64_t) exporter_period_ms * 1000;
+		}
+	}
+
+	return NULL;
+}
+
+int metrics_start_exporter(const char *file_path, const char *socket_path, unsigned int period_ms)
+{
+	if (exporter_running) return 0;
+	if ((file_path == NULL) && (socket_path == NULL)) return 0;
+
+	exporter_file = file_path;
+	exporter_socket = socket_path;
+	exporter_period_ms = (period_ms > 0) ? period_ms : 1000;
+	exporter_stop = false;
+
+	if (socket_path != NULL)
+	{
+		listen_fd = open_socket(socket_path);
+		if (listen_fd < 0)
+		{
+			fprintf(stderr, "metrics socket %s: %s\n", socket_path, strerror(errno));
+			return -1;
+		}
+	}
+
+	if (pthread_create(&exporter_thread, NULL, exporter_main, NULL) != 0)
+	{
+		fprintf(stderr, "metrics exporter thread create error\n");
+		if (listen_fd >= 0) close(listen_fd);
+		listen_fd = -1;
+		return -1;
+	}
+	exporter_running = true;
+
+	return 0;
+}
+
+void metrics_stop_exporter(void)
+{
+	if (!exporter_running) return;
+
+	__atomic_store_n(&exporter_stop, true, __ATOMIC_RELEASE);
+	pthread_join(exporter_thread, NULL);
+	exporter_running = false;
+
+	if (exporter_file != NULL)
+		export_file();
+	if (listen_fd >= 0)
+	{
+		close(listen_fd);
+		unlink(exporter_socket);
+		listen_fd = -1;
+	}
+}
@@ -0,0 +1,160 @@
+//-------------------------------------------------------------------
+// tracker_metrics.h - lock-free counters and gauges for the tracker
+//
+// Every tracker instance owns one TrackerMetrics block.  Counters are
+// only ever bumped by the thread that owns them (the control loop),
+// so an update is a relaxed load + store - no locked instruction.
+// Gauges are plain relaxed stores and may come from DDS listener
+// threads.  Observation-to-command latency goes into a log-linear
+// histogram (4 buckets per octave of microseconds).  A background
+// exporter renders all registered blocks as Prometheus text to a
+// file and/or a Unix domain socket.
+//-------------------------------------------------------------------
+#ifndef TRACKER_METRICS_H
+#define TRACKER_METRICS_H
+
+#include <stdint.h>
+
+#define METRICS_MAX_INSTANCES   8
+#define METRICS_LABEL_LEN       64
+#define METRICS_CACHE_LINE      64
+#define METRICS_LATENCY_BUCKETS 96
+
+enum TrackerCounter {
+	METRIC_SAMPLES_RECEIVED,
+	METRIC_SAMPLES_FILTERED,
+	METRIC_COMMANDS_WRITTEN,
+	METRIC_WRITE_FAILURES,
+	METRIC_LOOP_ITERATIONS,
+	METRIC_CONTROL_UPDATES,
+	METRIC_ERROR_SQUARED_SUM,
+	METRIC_DEADLINE_MISSES,
+	METRIC_TARGETS_LOST,
+	METRIC_REACQUISITIONS,
+	METRIC_SAMPLES_UNSELECTED,
+	METRIC_SAMPLES_OUT_OF_ORDER,
+	METRIC_SAMPLES_STALE,
+	METRIC_ROI_UPDATES,
+	METRIC_SAMPLES_GATED,
+	METRIC_WRITES_HELD,
+	METRIC_COUNTER_COUNT
+};
+
+enum TrackerGauge {
+	METRIC_MATCHED_PUBLISHERS,
+	METRIC_MATCHED_SUBSCRIBERS,
+	METRIC_PAN_POSITION,
+	METRIC_TILT_POSITION,
+	METRIC_TARGET_STATE,
+	METRIC_REACQUIRE_MS,
+	METRIC_CANDIDATES,
+	METRIC_SAMPLE_POOL_HIGH_WATER,
+	METRIC_GAUGE_COUNT
+};
+
+//-------------------------------------------------------------------
+// Counters and gauges live on separate cache lines so listener
+// threads setting gauges never bounce the control thread's line.
+//-------------------------------------------------------------------
+struct TrackerMetrics {
+	uint64_t counter[METRIC_COUNTER_COUNT] __attribute__((aligned(METRICS_CACHE_LINE)));
+	uint64_t latency[METRICS_LATENCY_BUCKETS];
+	uint64_t latency_sum;                      // us, for the histogram's _sum
+	uint64_t latency_max;                      // us, since metrics_take_latency_max()
+	int64_t  gauge[METRIC_GAUGE_COUNT]     __attribute__((aligned(METRICS_CACHE_LINE)));
+	char     label[METRICS_LABEL_LEN]      __attribute__((aligned(METRICS_CACHE_LINE)));
+};
+
+// Single-writer counter increment
+static inline void metrics_add(struct TrackerMetrics *m, enum TrackerCounter c, uint64_t n)
+{
+	__atomic_store_n(&m->counter[c], __atomic_load_n(&m->counter[c], __ATOMIC_RELAXED) + n, __ATOMIC_RELAXED);
+}
+
+static inline void metrics_count(struct TrackerMetrics *m, enum TrackerCounter c)
+{
+	metrics_add(m, c, 1);
+}
+
+static inline void metrics_set(struct TrackerMetrics *m, enum TrackerGauge g, int64_t value)
+{
+	__atomic_store_n(&m->gauge[g], value, __ATOMIC_RELAXED);
+}
+
+// Bucket index for a latency in microseconds: 0..3 are exact, after
+// that each power of two is split into four equal sub-buckets.
+static inline int metrics_latency_bucket(uint64_t us)
+{
+	int msb;
+	int index;
+
+	if (us < 4) return (int) us;
+	msb = 63 - __builtin_clzll(us);
+	index = (msb - 1) * 4 + (int) ((us >> (msb - 2)) & 3);
+
+	return (index < METRICS_LATENCY_BUCKETS) ? index : METRICS_LATENCY_BUCKETS - 1;
+}
+
+// Largest latency (us) that lands in the given bucket
+static inline uint64_t metrics_latency_bucket_limit(int index)
+{
+	int msb;
+
+	if (index < 4) return (uint64_t) index;
+	msb = index / 4 + 1;
+
+	return ((uint64_t) (5 + index % 4) << (msb - 2)) - 1;
+}
+
+// Single-writer latency observation
+static inline void metrics_observe_latency(struct TrackerMetrics *m, uint64_t us)
+{
+	uint64_t *bucket = &m->latency[metrics_latency_bucket(us)];
+
+	__atomic_store_n(bucket, __atomic_load_n(bucket, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+	__atomic_store_n(&m->latency_sum, __atomic_load_n(&m->latency_sum, __ATOMIC_RELAXED) + us, __ATOMIC_RELAXED);
+	if (us > __atomic_load_n(&m->latency_max, __ATOMIC_RELAXED))
+		__atomic_store_n(&m->latency_max, us, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t metrics_counter(const struct TrackerMetrics *m, enum TrackerCounter c)
+{
+	return __atomic_load_n(&m->counter[c], __ATOMIC_RELAXED);
+}
+
+static inline int64_t metrics_gauge(const struct TrackerMetrics *m, enum TrackerGauge g)
+{
+	return __atomic_load_n(&m->gauge[g], __ATOMIC_RELAXED);
+}
+
+// Copies the latency histogram; subtract two snapshots to get the
+// distribution over an interval.
+void metrics_latency_snapshot(const struct TrackerMetrics *m, uint64_t histogram[METRICS_LATENCY_BUCKETS]);
+
+// Largest latency observed since the previous call, and starts over.
+// Meant for one periodic reader; an observation racing the reset may
+// be counted in the next period instead.
+static inline uint64_t metrics_take_latency_max(struct TrackerMetrics *m)
+{
+	return __atomic_exchange_n(&m->latency_max, 0, __ATOMIC_RELAXED);
+}
+
+// Upper bound (us) of the bucket holding quantile q (0..1) of the
+// histogram, or 0 if it is empty.
+uint64_t metrics_latency_quantile(const uint64_t histogram[METRICS_LATENCY_BUCKETS], double q);
+
+// Returns a zeroed block labelled with the given Prometheus label set
+// (e.g. domain="53",color="GREEN"), or NULL once the registry is full.
+struct TrackerMetrics *metrics_register(const char *label);
+
+// Renders every registered block as Prometheus text.  Returns the
+// number of bytes written (truncated to len - 1).
+int metrics_format(char *buffer, int len);
+
+// Starts the exporter thread.  Either path may be NULL.  The file is
+// rewritten (atomically via rename) every period_ms; the socket answers
+// each connection with the current text and closes it.
+int metrics_start_exporter(const char *file_path, const char *socket_path, unsigned int period_ms);
+void metrics_stop_exporter(void);
+
+#endif
@@ -0,0 +1,65 @@
+//-------------------------------------------------------------------
+// tracker_probes.h - USDT static probes (provider "pixytracker")
+//
+// Where <sys/sdt.h> (systemtap-sdt-dev / systemtap-sdt-devel) is
+// installed the probes are compiled in.  An unattached probe is a
+// single nop; its arguments are values the code already has (or a
+// multiply-add away), so it costs nothing measurable.  bpftrace, perf
+// and stap patch the nop at attach time, so a running tracker can be
+// traced without a restart.  -DTRACKER_NO_USDT compiles them out;
+// elsewhere they expand to nothing.
+//
+// Instance-bound probes take the metrics label (domain="53",color=
+// "GREEN") as arg0.  source_us and reception_us are the DDS wall-clock
+// stamps of the Circle sample in microseconds; gimbal_update and
+// servo_write carry the source_us of the observation behind the step
+// or command (0 if none, e.g. coasting).  gimbal_update fires once
+// per axis stepped (0 pan, 1 tilt), with the interval given to the
+// law (0 if unknown); axes holding in the dead band do not fire it.
+//
+//   sample            label, x, y, size, source_us, reception_us
+//   reject            label, reason (1 out of order, 2 stale, 3 gated), source_us
+//   control           label, pan_error, tilt_error, pan, tilt, source_us
+//   gimbal_update     label, axis, error, interval_us, position, previous_error, source_us
+//   servo_write       label, pan, tilt, source_us, retcode
+//   publication_matched / subscription_matched   label, current_count
+//   deadline_missed   label
+//-------------------------------------------------------------------
+#ifndef TRACKER_PROBES_H
+#define TRACKER_PROBES_H
+
+#if defined(__linux__) && !defined(TRACKER_NO_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define TRACKER_USDT 1
+#endif
+#endif
+
+#define TRACKER_PROBE_REJECT_OUT_OF_ORDER 1
+#define TRACKER_PROBE_REJECT_STALE        2
+#define TRACKER_PROBE_REJECT_GATED        3
+
+#if defined(TRACKER_USDT)
+
+#include <sys/sdt.h>
+
+#define TRACKER_PROBE1(name, a)                   DTRACE_PROBE1(pixytracker, name, a)
+#define TRACKER_PROBE2(name, a, b)                DTRACE_PROBE2(pixytracker, name, a, b)
+#define TRACKER_PROBE3(name, a, b, c)             DTRACE_PROBE3(pixytracker, name, a, b, c)
+#define TRACKER_PROBE4(name, a, b, c, d)          DTRACE_PROBE4(pixytracker, name, a, b, c, d)
+#define TRACKER_PROBE5(name, a, b, c, d, e)       DTRACE_PROBE5(pixytracker, name, a, b, c, d, e)
+#define TRACKER_PROBE6(name, a, b, c, d, e, f)    DTRACE_PROBE6(pixytracker, name, a, b, c, d, e, f)
+#define TRACKER_PROBE7(name, a, b, c, d, e, f, g) DTRACE_PROBE7(pixytracker, name, a, b, c, d, e, f, g)
+
+#else
+
+#define TRACKER_PROBE1(name, a)                   do {} while (0)
+#define TRACKER_PROBE2(name, a, b)                do {} while (0)
+#define TRACKER_PROBE3(name, a, b, c)             do {} while (0)
+#define TRACKER_PROBE4(name, a, b, c, d)          do {} while (0)
+#define TRACKER_PROBE5(name, a, b, c, d, e)       do {} while (0)
+#define TRACKER_PROBE6(name, a, b, c, d, e, f)    do {} while (0)
+#define TRACKER_PROBE7(name, a, b, c, d, e, f, g) do {} while (0)
+
+#endif
+
+#endif
@@ -0,0 +1,44 @@
+//-------------------------------------------------------------------
+// tracker_time.h - microsecond clocks shared by the tracker modules
+//
+// DDS source/reception timestamps are wall-clock time, so latency
+// against them uses CLOCK_REALTIME.  Intervals and timeouts that
+// must not jump with NTP use CLOCK_MONOTONIC.
+//-------------------------------------------------------------------
+#ifndef TRACKER_TIME_H
+#define TRACKER_TIME_H
+
+#include <stdint.h>
+#include <time.h>
+#include <sys/resource.h>
+
+static inline int64_t time_realtime_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static inline int64_t time_monotonic_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// User + system CPU of the whole process, for the benchmarks
+static inline int64_t time_process_cpu_us(void)
+{
+	struct rusage usage;
+
+	getrusage(RUSAGE_SELF, &usage);
+	return (int64_t) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000
+			+ usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+// DDS_Time_t (or anything with sec/nanosec members) to microseconds
+#define DDS_TIME_TO_US(t) ((int64_t) (t).sec * 1000000 + (int64_t) (t).nanosec / 1000)
+
+#endif
@@ -0,0 +1,116 @@
+#include <string.h>
+#include "trajectory.h"
+
+static const char *modeName[] = {
+	"off",
+	"accel",
+	"jerk"
+};
+
+//-------------------------------------------------------------------
+// Integer square root: estimate from the bit length, then Newton
+//-------------------------------------------------------------------
+static uint32_t isqrt64(uint64_t value)
+{
+	uint64_t root;
+	uint64_t next;
+
+	if (value < 2) return (uint32_t) value;
+	root = (uint64_t) 1 << ((64 - __builtin_clzll(value) + 1) / 2);
+	for (;;)
+	{
+		next = (root + value / root) >> 1;
+		if (next >= root) break;
+		root = next;
+	}
+	return (uint32_t) root;
+}
+
+static int32_t clamp(int32_t value, int32_t low, int32_t high)
+{
+	return (value < low) ? low : ((value > high) ? high : value);
+}
+
+void trajectory_init(struct TrajectoryAxis *axis, enum TrajectoryMode mode, int32_t position, int32_t min_pos, int32_t max_pos,
+		int32_t tick_hz, int32_t max_velocity, int32_t max_accel, int32_t max_jerk)
+{
+	const int64_t one = (int64_t) 1 << TRAJ_FRACTION_BITS;
+	const int64_t hz = tick_hz;
+
+	axis->position = position << TRAJ_FRACTION_BITS;
+	axis->target = axis->position;
+	axis->velocity = 0;
+	axis->accel = 0;
+	axis->min_pos = min_pos;
+	axis->max_pos = max_pos;
+
+	// Convert per-second limits to per-tick, never below one LSB
+	axis->max_velocity = (int32_t) (max_velocity * one / hz);
+	axis->max_accel    = (int32_t) (max_accel * one / (hz * hz));
+	axis->max_jerk     = (mode == TRAJECTORY_JERK) ? (int32_t) (max_jerk * one / (hz * hz * hz)) : 0;
+	if (axis->max_velocity < 1) axis->max_velocity = 1;
+	if (axis->max_accel < 1) axis->max_accel = 1;
+	if ((mode == TRAJECTORY_JERK) && (axis->max_jerk < 1)) axis->max_jerk = 1;
+}
+
+//-------------------------------------------------------------------
+// Chase the target with the fastest velocity that can still stop in
+// the remaining distance: v = sqrt(2 a d), less the distance covered
+// while the jerk limit ramps the deceleration in.
+//-------------------------------------------------------------------
+int32_t trajectory_step(struct TrajectoryAxis *axis)
+{
+	int32_t error = axis->target - axis->position;
+	int32_t distance = (error < 0) ? -error : error;
+	int32_t speed = (axis->velocity < 0) ? -axis->velocity : axis->velocity;
+	int32_t desired;
+	int32_t accel;
+
+	// Close enough and slow enough: settle exactly on the target
+	if ((distance <= axis->max_accel) && (speed <= axis->max_accel))
+	{
+		axis->position = axis->target;
+		axis->velocity = 0;
+		axis->accel = 0;
+		return trajectory_position(axis);
+	}
+
+	accel = axis->max_accel;
+	if (axis->max_jerk != 0)
+		distance -= (int32_t) ((int64_t) speed * accel / axis->max_jerk);
+	if (distance < 0) distance = 0;
+
+	desired = (int32_t) ((isqrt64((uint64_t) accel * accel + (uint64_t) 8 * accel * (uint32_t) distance) - accel) >> 1);
+	if (desired > axis->max_velocity) desired = axis->max_velocity;
+	if (error < 0) desired = -desired;
+
+	accel = clamp(desired - axis->velocity, -axis->max_accel, axis->max_accel);
+	if (axis->max_jerk != 0)
+	{
+		// Ease off so acceleration reaches zero as the velocity arrives
+		int32_t jerk = axis->max_jerk;
+		int32_t change = (accel < 0) ? axis->velocity - desired : desired - axis->velocity;
+		int32_t limit = (int32_t) ((isqrt64((uint64_t) jerk * jerk + (uint64_t) 8 * jerk * (uint32_t) change) - jerk) >> 1);
+
+		if (accel > limit) accel = limit;
+		else if (accel < -limit) accel = -limit;
+		accel = clamp(accel, axis->accel - jerk, axis->accel + jerk);
+	}
+
+	axis->accel = accel;
+	axis->velocity += accel;
+	axis->position += axis->velocity;
+	axis->position = clamp(axis->position, axis->min_pos << TRAJ_FRACTION_BITS, axis->max_pos << TRAJ_FRACTION_BITS);
+
+	return trajectory_position(axis);
+}
+
+int trajectory_mode_parse(const char *name)
+{
+	for (int mode = TRAJECTORY_OFF; mode <= TRAJECTORY_JERK; mode++)
+	{
+		if (strcmp(name, modeName[mode]) == 0)
+			return mode;
+	}
+	return -1;
+}
@@ -0,0 +1,61 @@
+//-------------------------------------------------------------------
+// trajectory.h - servo output stage with motion limits
+//
+// The controller produces a new target only when a Circle sample
+// arrives.  The trajectory stage turns those targets into a smooth
+// path emitted once per servo tick (ServoControl.frequency), with
+// velocity, acceleration and optionally jerk limits.  Fixed point
+// throughout (Q8 servo units, per-tick rates), no allocation.
+//-------------------------------------------------------------------
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <stdint.h>
+
+#define TRAJ_FRACTION_BITS 8
+
+// Defaults in servo units per second (^2, ^3)
+#define TRAJ_MAX_VELOCITY  2000
+#define TRAJ_MAX_ACCEL     20000
+#define TRAJ_MAX_JERK      400000
+
+enum TrajectoryMode {
+	TRAJECTORY_OFF,    // write controller output directly (original behaviour)
+	TRAJECTORY_ACCEL,  // velocity and acceleration limited
+	TRAJECTORY_JERK    // velocity, acceleration and jerk limited
+};
+
+struct TrajectoryAxis {
+	int32_t position;      // Q8
+	int32_t velocity;      // Q8 per tick
+	int32_t accel;         // Q8 per tick^2
+	int32_t target;        // Q8
+	int32_t max_velocity;
+	int32_t max_accel;
+	int32_t max_jerk;      // 0 when jerk is not limited
+	int32_t min_pos;
+	int32_t max_pos;
+};
+
+void trajectory_init(struct TrajectoryAxis *axis, enum TrajectoryMode mode, int32_t position, int32_t min_pos, int32_t max_pos,
+		int32_t tick_hz, int32_t max_velocity, int32_t max_accel, int32_t max_jerk);
+
+static inline void trajectory_set_target(struct TrajectoryAxis *axis, int32_t target)
+{
+	if (target < axis->min_pos) target = axis->min_pos;
+	else if (target > axis->max_pos) target = axis->max_pos;
+	axis->target = target << TRAJ_FRACTION_BITS;
+}
+
+static inline int32_t trajectory_position(const struct TrajectoryAxis *axis)
+{
+	return (axis->position + (1 << (TRAJ_FRACTION_BITS - 1))) >> TRAJ_FRACTION_BITS;
+}
+
+// Advances one servo tick and returns the position to command
+int32_t trajectory_step(struct TrajectoryAxis *axis);
+
+// Parses "off", "accel" or "jerk"; returns -1 if unknown
+int trajectory_mode_parse(const char *name);
+
+#endif
@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <string.h>
+#include "transport.h"
+
+static const char *transportName[] = {
+	"udp",
+	"shmem",
+	"auto"
+};
+
+DDSDomainParticipant *transport_create_participant(int domain_id, const char *library, const char *profile,
+		enum TrackerTransport transport)
+{
+	DDS_DomainParticipantQos qos;
+
+	if (transport == TRANSPORT_UDP)
+		return DDSTheParticipantFactory->create_participant_with_profile(domain_id, library, profile, NULL, DDS_STATUS_MASK_NONE);
+
+	if (DDSTheParticipantFactory->get_participant_qos_from_profile(qos, library, profile) != DDS_RETCODE_OK)
+	{
+		fprintf(stderr, "participant QoS %s::%s not found\n", library, profile);
+		return NULL;
+	}
+
+	if (transport == TRANSPORT_SHMEM)
+	{
+		// Multicast discovery cannot work without UDP; find peers in shared memory
+		qos.transport_builtin.mask = DDS_TRANSPORTBUILTIN_SHMEM;
+		qos.discovery.multicast_receive_addresses.length(0);
+		qos.discovery.initial_peers.ensure_length(1, 1);
+		DDS_String_free(qos.discovery.initial_peers[0]);
+		qos.discovery.initial_peers[0] = DDS_String_dup("shmem://");
+	}
+	else
+		qos.transport_builtin.mask = DDS_TRANSPORTBUILTIN_UDPv4 | DDS_TRANSPORTBUILTIN_SHMEM;
+
+	return DDSTheParticipantFactory->create_participant(domain_id, qos, NULL, DDS_STATUS_MASK_NONE);
+}
+
+DDSDataReader *transport_create_datareader(DDSDomainParticipant *participant, DDSTopicDescription *topic,
+		const char *library, const char *profile, enum TrackerTransport transport,
+		DDSDataReaderListener *listener, DDS_StatusMask mask)
+{
+	DDS_DataReaderQos qos;
+
+	if (transport == TRANSPORT_UDP)
+		return participant->create_datareader_with_profile(topic, library, profile, listener, mask);
+
+	if (participant->get_datareader_qos_from_profile(qos, library, profile) != DDS_RETCODE_OK)
+	{
+		fprintf(stderr, "datareader QoS %s::%s not found\n", library, profile);
+		return NULL;
+	}
+	// A multicast locator would make co-located writers send over UDP
+	qos.multicast.value.length(0);
+
+	return participant->create_datareader(topic, qos, listener, mask);
+}
+
+int transport_parse(const char *name)
+{
+	for (int transport = TRANSPORT_UDP; transport <= TRANSPORT_AUTO; transport++)
+	{
+		if (strcmp(name, transportName[transport]) == 0)
+			return transport;
+	}
+	return -1;
+}
+
+const char *transport_name(enum TrackerTransport transport)
+{
+	return transportName[transport];
+}
@@ -0,0 +1,40 @@
+//-------------------------------------------------------------------
+// transport.h - which built-in transports the tracker uses
+//
+// The XML profiles pin the participant to UDPv4 and give the Circle
+// reader a multicast address.  When the Pixy bridge runs on the same
+// host, shared memory avoids the loopback UDP stack altogether:
+//
+//   udp    UDPv4 only, as configured in the profile (the default)
+//   shmem  shared memory only; discovery and data never leave the host
+//   auto   UDPv4 + shared memory without reader multicast, so Connext
+//          picks shared memory for peers on this host and unicast UDP
+//          for the rest
+//
+// The profile still supplies every other QoS setting.
+//-------------------------------------------------------------------
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include "ndds/ndds_cpp.h"
+
+enum TrackerTransport {
+	TRANSPORT_UDP,
+	TRANSPORT_SHMEM,
+	TRANSPORT_AUTO
+};
+
+DDSDomainParticipant *transport_create_participant(int domain_id, const char *library, const char *profile,
+		enum TrackerTransport transport);
+
+// The reader QoS from the profile, minus multicast where the transport
+// cannot or should not use it
+DDSDataReader *transport_create_datareader(DDSDomainParticipant *participant, DDSTopicDescription *topic,
+		const char *library, const char *profile, enum TrackerTransport transport,
+		DDSDataReaderListener *listener, DDS_StatusMask mask);
+
+// Parses "udp", "shmem" or "auto"; returns -1 if unknown
+int transport_parse(const char *name);
+const char *transport_name(enum TrackerTransport transport);
+
+#endif